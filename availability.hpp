@@ -0,0 +1,88 @@
+#ifndef __availability__hpp
+#define __availability__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define NB_KERNEL_LANES 4   // Independent partial sums kept by the kernels. Lets the compiler vectorize them without reordering the additions.
+
+
+/****************************************************************************************
+ * Availability kernels. Availabilities are handled in log space: the failure probability
+ * of a set of nodes is the sum of their log(1 - a_v), and the availability of a chain is
+ * the sum of its sections log availabilities. Sums are accumulated in NB_KERNEL_LANES
+ * partial sums that are combined in a fixed order, so a given input always produces the
+ * same bits, whichever caller and however the compiler vectorizes the loop.
+****************************************************************************************/
+
+/** Returns log(1 - exp(logFailure)), the log availability of a set of nodes whose log failure probability is given. Accurate whether the failure is close to 0 or to 1. **/
+inline double getLogAvailabilityFromLogFailure(const double logFailure)
+{
+    if (logFailure > -M_LN2){
+        return std::log(-std::expm1(logFailure));
+    }
+    return std::log1p(-std::exp(logFailure));
+}
+
+/** Returns 1 - exp(logFailure), the availability of a set of nodes whose log failure probability is given. **/
+inline double getAvailabilityFromLogFailure(const double logFailure)
+{
+    return -std::expm1(logFailure);
+}
+
+/** Returns the sum of the first n values. @param values The values to be summed. @param n The number of values. **/
+inline double sumLogValues(const double* values, const int n)
+{
+    double lane[NB_KERNEL_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+    int v = 0;
+    for (; v + NB_KERNEL_LANES <= n; v += NB_KERNEL_LANES){
+        for (int l = 0; l < NB_KERNEL_LANES; l++){
+            lane[l] += values[v + l];
+        }
+    }
+    for (int l = 0; v < n; v++, l++){
+        lane[l] += values[v];
+    }
+    return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+}
+
+/** Returns the sum of logFailure[v] over the nodes v such that values[v] >= threshold. The mask is applied with a select, so the loop has no branch. @param logFailure The log failure probability of each node. @param values The value of each node, typically its placement variable. @param n The number of nodes. @param threshold The smallest value of a selected node. **/
+inline double sumLogFailureMasked(const double* logFailure, const double* values, const int n, const double threshold)
+{
+    double lane[NB_KERNEL_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+    int v = 0;
+    for (; v + NB_KERNEL_LANES <= n; v += NB_KERNEL_LANES){
+        for (int l = 0; l < NB_KERNEL_LANES; l++){
+            lane[l] += (values[v + l] >= threshold) ? logFailure[v + l] : 0.0;
+        }
+    }
+    for (int l = 0; v < n; v++, l++){
+        lane[l] += (values[v] >= threshold) ? logFailure[v] : 0.0;
+    }
+    return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+}
+
+/** Returns the sum of logFailure[v] over a list of nodes. @param logFailure The log failure probability of each node. @param nodes The node ids. @param n The number of nodes in the list. **/
+inline double sumLogFailureGathered(const double* logFailure, const int* nodes, const int n)
+{
+    double lane[NB_KERNEL_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+    int j = 0;
+    for (; j + NB_KERNEL_LANES <= n; j += NB_KERNEL_LANES){
+        for (int l = 0; l < NB_KERNEL_LANES; l++){
+            lane[l] += logFailure[nodes[j + l]];
+        }
+    }
+    for (int l = 0; j < n; j++, l++){
+        lane[l] += logFailure[nodes[j]];
+    }
+    return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+}
+
+#endif
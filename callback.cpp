@@ -4,15 +4,36 @@
 /*										CONSTRUCTOR										*/
 /****************************************************************************************/
 
-Callback::Callback(const IloEnv& env_, const Data& data_, const IloNumVar3DMatrix& x_) :
-	                env(env_), data(data_),	x(x_)
+Callback::Callback(const IloEnv& env_, const Data& data_, const IloNumVar3DMatrix& x_, const IloNumVarMatrix& y_, const int nbThreads) :
+	                env(env_), data(data_), hot(data_.getHotData()), x(x_), y(y_), xArray(env_, (IloInt)x_.size()), 
+                    heuristicVars(env_, (IloInt)(x_.size() + (std::size_t)data_.getHotData().getNbNodes() * data_.getHotData().getNbVnfs())),
+                    stats(nbThreads, data_.getHotData().getNbDemands()), policy(data_.getInput(), nbThreads)
 {	
-	/*** Control ***/
-    thread_flag.lock();
-	nb_cuts_avail_heuristic = 0;
-    nbLazyConstraints = 0;
-	timeAll = 0.0;
-    thread_flag.unlock();
+	for (std::size_t n = 0; n < x.size(); n++){
+		xArray[n] = x[n];
+		heuristicVars[n] = x[n];
+	}
+	for (int v = 0; v < hot.getNbNodes(); v++){
+		for (int f = 0; f < hot.getNbVnfs(); f++){
+			heuristicVars[x.size() + (std::size_t)v * hot.getNbVnfs() + f] = y[v][f];
+		}
+	}
+
+	/*** Scratch memory: one workspace per thread, allocated once ***/
+	workspaces.reserve(nbThreads);
+	for (int t = 0; t < nbThreads; t++){
+		workspaces.push_back(Workspace(env, hot, t));
+	}
+
+	/*** Separation workers: worker 0 is the calling thread, which keeps its own workspace for the solution ***/
+	const int nbWorkers = data.getInput().getSeparationThreads();
+	if (nbWorkers > 1){
+		workers.reset(new WorkerPool(nbWorkers));
+		workerSpaces.reserve(nbWorkers);
+		for (int w = 0; w < nbWorkers; w++){
+			workerSpaces.push_back(Workspace(env, hot, w, false));
+		}
+	}
 }
 
 /****************************************************************************************/
@@ -21,6 +42,7 @@ Callback::Callback(const IloEnv& env_, const Data& data_, const IloNumVar3DMatri
 void Callback::invoke(const Context& context)
 {
     IloNum time = context.getDoubleInfo(IloCplex::Callback::Context::Info::Time);
+    CallbackStats::ContextType type = CallbackStats::RELAXATION;
     switch (context.getId()){
         /* Fractional solution */
         case Context::Id::Relaxation:
@@ -29,6 +51,7 @@ void Callback::invoke(const Context& context)
 
         /* Integer solution */
         case Context::Id::Candidate:
+            type = CallbackStats::CANDIDATE;
 			if (context.isCandidatePoint()) {
 	    		addLazyConstraints(context);
 			}
@@ -39,7 +62,7 @@ void Callback::invoke(const Context& context)
 			throw IloCplex::Exception(-1, "ERROR: Unexpected context id !");
     }
     time = context.getDoubleInfo(IloCplex::Callback::Context::Info::Time) - time;
-    incrementTime(time);
+    incrementTime(getWorkspace(context).thread, type, time);
 }
 
 void Callback::addUserCuts(const Context &context)
@@ -47,8 +70,27 @@ void Callback::addUserCuts(const Context &context)
     
     //std::cout << "Entering user cut separation... "  << std::endl;
     try {    
-        IloNum3DMatrix xSol = getFractionalSolution(context);
-        heuristicSeparationOfAvailibilityConstraints(context, xSol);
+        Workspace& workspace = getWorkspace(context);
+        long depth = context.getLongInfo(IloCplex::Callback::Context::Info::NodeDepth);
+        long nodeCount = context.getLongInfo(IloCplex::Callback::Context::Info::NodeCount);
+        double now = context.getDoubleInfo(IloCplex::Callback::Context::Info::Time);
+        const bool separate = policy.shouldSeparate(workspace.thread, depth, nodeCount, now, stats.getTime());
+        const bool round = (depth <= data.getInput().getHeuristicMaxDepth());
+        if (!separate){
+            stats.addSkippedRound(workspace.thread);
+            if (!round){
+                return;
+            }
+        }
+        getFractionalSolution(context, workspace);
+        int nbCuts = 0;
+        if (separate){
+            nbCuts = separationOfAvailabilityConstraints(context, workspace, depth);
+        }
+        /* Round once the relaxation of the node is final: when no cut was added to it. */
+        if (round && nbCuts == 0){
+            postRoundedSolution(context, workspace);
+        }
     }
     catch (...) {
         throw;
@@ -57,196 +99,377 @@ void Callback::addUserCuts(const Context &context)
 }
 
 
-void Callback::initiateHeuristic(const int k, std::vector< std::vector<int> >& coeff, std::vector< std::vector<int> >& sectionNodes, std::vector< double >& sectionAvailability, const IloNum3DMatrix& xSol)
+void Callback::initiateHeuristic(const int k, const IloNum3DMatrix& xSol, Workspace& workspace)
 {
-    
-    coeff.resize(data.getDemand(k).getNbVNFs());
-    sectionNodes.resize(data.getDemand(k).getNbVNFs());
-    sectionAvailability.resize(data.getDemand(k).getNbVNFs());
-    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-        coeff[i].resize(xSol[k][i].size());
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            int v = data.getNodeId(n);
-            coeff[i][v] = 1;
-        }
-    }
+    FlatMatrix<int>& coeff = workspace.coeff;
+    FlatMatrix<int>& sectionNodes = workspace.sectionNodes;
+    std::vector<int>& nbSectionNodes = workspace.nbSectionNodes;
+    std::vector<double>& sectionAvailability = workspace.sectionAvailability;
+    workspace.reset(hot.getNbSections(k), hot.getMaxCandidates());
 
     /* Initialization of placement */
-    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-        /* Place every integer variable */
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            int v = data.getNodeId(n);
-            if (xSol[k][i][v] >= 1 - EPS){
-                sectionNodes[i].push_back(v);
-                coeff[i][v] = 0;
+    for (int i = 0; i < hot.getNbSections(k); i++){
+        /* Place every integer variable. */
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            if (xSol(k, i, p) >= 1 - EPS){
+                sectionNodes(i, nbSectionNodes[i]++) = p;
+                coeff(i, p) = 0;
             }
         }
         /* If still empty, select some initial node based on the best x/availability ratio. */
-        if (sectionNodes[i].empty()){
-            int selectedNode = -1;
+        if (nbSectionNodes[i] == 0){
+            int selectedPosition = -1;
             double bestValue = -1.0;
-            for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                int v = data.getNodeId(n);
-                if ( (xSol[k][i][v] / data.getNode(v).getAvailability()) > bestValue){
-                    bestValue = (xSol[k][i][v] / data.getNode(v).getAvailability());
-                    selectedNode = v;
+            for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                const int v = hot.getCandidate(k, i, p);
+                if ( (xSol(k, i, p) / hot.getAvailability(v)) > bestValue){
+                    bestValue = (xSol(k, i, p) / hot.getAvailability(v));
+                    selectedPosition = p;
                 }
             }
-            sectionNodes[i].push_back(selectedNode);
-            coeff[i][selectedNode] = 0;
+            sectionNodes(i, nbSectionNodes[i]++) = selectedPosition;
+            coeff(i, selectedPosition) = 0;
+        }
+        /* Set initial section availability. Integer placements go through the same kernel as the integer separation. */
+        if (xSol(k, i, sectionNodes(i, 0)) >= 1 - EPS){
+            workspace.sectionLogFailure[i] = getSectionLogFailure(k, i, xSol);
+        }
+        else{
+            workspace.sectionLogFailure[i] = hot.getLogFailure(hot.getCandidate(k, i, sectionNodes(i, 0)));
         }
-        /* Set initial section availability. */
-        sectionAvailability[i] = 1.0 - data.getFailureProb(sectionNodes[i]);
+        sectionAvailability[i] = getAvailabilityFromLogFailure(workspace.sectionLogFailure[i]);
+        workspace.sectionLogAvailability[i] = getLogAvailabilityFromLogFailure(workspace.sectionLogFailure[i]);
     }
 }
 
-/* Greedly solves the separation problem associated with the availability constraints. */
-void Callback::heuristicSeparationOfAvailibilityConstraints(const Context &context, const IloNum3DMatrix& xSol)
+/* Separates availability cuts on the current fractional solution, demand by demand, with the algorithm chosen in the parameters. */
+int Callback::separationOfAvailabilityConstraints(const Context &context, Workspace& workspace, const long depth)
 {
-    /* Check VNF placement availability for each demand */
-    for (int k = 0; k < data.getNbDemands(); k++){
-        
-        /* Declare auxiliary structures. */
-        std::vector< std::vector<int> > coeff;          // the variable coefficient in the constraint
-        std::vector< std::vector<int> > sectionNodes;   // the set of nodes placed in each section
-        std::vector< double > sectionAvailability;      // the availability assoaciated with the placement
-        
-        initiateHeuristic(k, coeff, sectionNodes, sectionAvailability, xSol);
+    /* Demands are independent: when CPLEX leaves cores idle, as at the root or with few threads, they are split among the workers. */
+    if (workers && (depth == 0 || context.getIntInfo(IloCplex::Callback::Context::Info::Threads) < workers->getNbWorkers())){
+        std::unique_lock<std::mutex> guard(workers->getLock(), std::try_to_lock);
+        if (guard.owns_lock()){
+            std::atomic<int> next(0);
+            workers->run([&](const int w){
+                Workspace& scratch = workerSpaces[w];
+                scratch.clearCuts();
+                for (int first = next.fetch_add(SEPARATION_CHUNK_SIZE); first < hot.getNbDemands(); first = next.fetch_add(SEPARATION_CHUNK_SIZE)){
+                    for (int k = first; k < std::min(first + SEPARATION_CHUNK_SIZE, hot.getNbDemands()); k++){
+                        separateDemand(k, workspace, scratch);
+                    }
+                }
+            });
+            return addAvailabilityCuts(context, workspace, workerSpaces.data(), (int)workerSpaces.size());
+        }
+    }
+    workspace.clearCuts();
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        separateDemand(k, workspace, workspace);
+    }
+    return addAvailabilityCuts(context, workspace, &workspace, 1);
+}
 
-        double chainAvailability = data.getChainAvailability(sectionAvailability);
-        const double REQUIRED_AVAIL = data.getDemand(k).getAvailability(); 
-        
-        if (chainAvailability < REQUIRED_AVAIL){
-            std::vector< std::vector<double> > deltaAvailability;
-            deltaAvailability.resize(data.getDemand(k).getNbVNFs());
-            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                deltaAvailability[i].resize(xSol[k][i].size());
+/* Separates the availability constraints of demand k on the solution of owner and buffers the cut found in scratch. */
+void Callback::separateDemand(const int k, Workspace& owner, Workspace& scratch)
+{
+    const Separation_Mode mode = data.getInput().getSeparationMode();
+    const IloNum3DMatrix& xSol = owner.xSol;
+
+    /* Separation is deterministic: a demand whose values did not change and gave no cut gives none again. */
+    uint64_t fingerprint = fingerprintValues(xSol.data() + xSol.begin(k), xSol.end(k) - xSol.begin(k));
+    if (fingerprint == owner.relaxationFingerprint[k] && !owner.relaxationViolated[k]){
+        scratch.nbSkippedDemands++;
+        return;
+    }
+    owner.relaxationFingerprint[k] = fingerprint;
+
+    bool found = false;
+    if (mode != SEPARATION_KNAPSACK){
+        found = heuristicSeparationOfAvailibilityConstraints(k, xSol, scratch);
+    }
+    if (!found && mode != SEPARATION_HEURISTIC){
+        found = knapsackSeparationOfAvailabilityConstraints(k, xSol, scratch);
+    }
+    owner.relaxationViolated[k] = found;
+    if (found){
+        bufferAvailabilityCut(k, xSol, scratch);
+    }
+}
+
+/* Adds the cuts buffered in the scratch workspaces by increasing demand, so the cuts added do not depend on how demands were split. */
+int Callback::addAvailabilityCuts(const Context &context, Workspace& workspace, Workspace* scratch, const int nbScratch)
+{
+    int nbCuts = 0;
+    double totalEfficacy = 0.0;
+    int nbSkipped = 0;
+    std::vector<int> next(nbScratch, 0);
+    for (int w = 0; w < nbScratch; w++){
+        nbSkipped += scratch[w].nbSkippedDemands;
+    }
+    /* Each buffer is already sorted by demand, since workers take chunks in increasing order: merge them. */
+    while (true){
+        int best = -1;
+        for (int w = 0; w < nbScratch; w++){
+            if (next[w] < scratch[w].getNbCuts() && (best == -1 || scratch[w].cutDemand[next[w]] < scratch[best].cutDemand[next[best]])){
+                best = w;
             }
+        }
+        if (best == -1){
+            break;
+        }
+        totalEfficacy += addAvailabilityCut(context, workspace, scratch[best], next[best]++);
+        nbCuts++;
+    }
+    for (int n = 0; n < nbSkipped; n++){
+        stats.addSkippedDemand(workspace.thread, CallbackStats::RELAXATION);
+    }
+    policy.recordRound(workspace.thread, nbCuts, totalEfficacy);
+    return nbCuts;
+}
 
-            bool STOP = false;
-            while (!STOP){
-                computeDeltaAvailability(REQUIRED_AVAIL, deltaAvailability, sectionAvailability, coeff);  
-                int nextSection = -1;
-                int nextNode = -1;
-                double bestRatio = -1.0;
-
-                /* Search for next vnf to include on placement without satifying the chain availability. */
-                for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                        int v = data.getNodeId(n);
-                        if ((chainAvailability + deltaAvailability[i][v] < REQUIRED_AVAIL) && ((xSol[k][i][v] + EPS/deltaAvailability[i][v]) > bestRatio)){
-                            bestRatio = (xSol[k][i][v]/deltaAvailability[i][v]);
-                            nextSection = i;
-                            nextNode = v;
-                        }
-                    }
-                }
-                /* If a vnf is found, include it. */
-                if ((nextSection != -1) && (nextNode != -1)){
-                    chainAvailability += deltaAvailability[nextSection][nextNode];
-                    sectionAvailability[nextSection] = (1.0 - ((1.0 - sectionAvailability[nextSection])*(1.0 - data.getNode(nextNode).getAvailability())));
-                    coeff[nextSection][nextNode] = 0;
-                    sectionNodes[nextSection].push_back(nextNode);
+/* Rounds the current fractional solution into a feasible placement and posts it to CPLEX if it improves on the incumbent. */
+void Callback::postRoundedSolution(const Context &context, Workspace& workspace)
+{
+    RoundingHeuristic& rounding = workspace.rounding;
+    bool posted = false;
+    if (rounding.round(workspace.xSol) && rounding.cost < context.getDoubleInfo(IloCplex::Callback::Context::Info::BestSolution) - EPS){
+        /* The placement is stored in the storage order of x, followed by the y values. */
+        IloNumArray& values = workspace.heuristicValues;
+        for (std::size_t n = 0; n < rounding.placement.size(); n++){
+            values[n] = rounding.placement[n];
+        }
+        for (std::size_t m = 0; m < rounding.installed.size(); m++){
+            values[x.size() + m] = rounding.installed[m];
+        }
+        context.postHeuristicSolution(heuristicVars, values, rounding.cost, IloCplex::Callback::Context::SolutionStrategy::CheckFeasible);
+        posted = true;
+    }
+    stats.addHeuristicRun(workspace.thread, posted);
+}
+
+/* Greedly solves the separation problem associated with the availability constraints of demand k. */
+bool Callback::heuristicSeparationOfAvailibilityConstraints(const int k, const IloNum3DMatrix& xSol, Workspace& workspace)
+{
+    FlatMatrix<int>& coeff = workspace.coeff;                           // the variable coefficient in the constraint
+    FlatMatrix<int>& sectionNodes = workspace.sectionNodes;             // the set of nodes placed in each section
+    std::vector<int>& nbSectionNodes = workspace.nbSectionNodes;
+    std::vector<double>& sectionAvailability = workspace.sectionAvailability;  // the availability assoaciated with the placement
+    std::vector<double>& sectionFactor = workspace.sectionFactor;
+
+    initiateHeuristic(k, xSol, workspace);
+
+    const double REQUIRED_AVAIL = hot.getRequiredAvailability(k); 
+    const double chainLogAvailability = data.getChainLogAvailability(workspace.sectionLogAvailability);
+    
+    if (chainLogAvailability < hot.getLogRequiredAvailability(k)){
+        double chainAvailability = std::exp(chainLogAvailability);
+        /* Placing node v on section i increases the chain availability by sectionFactor[i] * a_v. 
+           Candidates are therefore ranked within a section by (x + EPS)/a_v, and the ones that keep 
+           the chain violated are the first candidates by increasing availability, up to a threshold. */
+        for (int i = 0; i < hot.getNbSections(k); i++){
+            sectionFactor[i] = getSectionFactor(REQUIRED_AVAIL, sectionAvailability[i]);
+            buildCandidates(k, i, xSol, workspace);
+        }
+
+        bool STOP = false;
+        while (!STOP){
+            int nextSection = -1;
+            int nextRank = -1;
+            double bestRatio = -1.0;
+
+            /* Search for next vnf to include on placement without satifying the chain availability. */
+            for (int i = 0; i < hot.getNbSections(k); i++){
+                int nbFeasible = hot.getNbCandidates(k, i);
+                if (sectionFactor[i] > 0.0){
+                    const double* sortedAvailability = hot.getCandidateSortedAvailabilities().data() + hot.getFirstColumn(k, i);
+                    double threshold = (REQUIRED_AVAIL - chainAvailability) / sectionFactor[i];
+                    nbFeasible = (int)(std::lower_bound(sortedAvailability, sortedAvailability + nbFeasible, threshold) - sortedAvailability);
                 }
-                /* If not, stop */
-                else{
-                    STOP = true;
+                int q = workspace.getBestCandidate(i, nbFeasible);
+                if (q != -1){
+                    double ratio = (sectionFactor[i] > 0.0) ? workspace.candidateWeight(i, q) / sectionFactor[i] : IloInfinity;
+                    if (ratio > bestRatio){
+                        bestRatio = ratio;
+                        nextSection = i;
+                        nextRank = q;
+                    }
                 }
             }
-            
-            double lhs = 0.0;
-            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                    int v = data.getNodeId(n);
-                    lhs += (coeff[i][v]*xSol[k][i][v]);
-                }
+            /* If a vnf is found, include it. Only the chosen section changes. */
+            if ((nextSection != -1) && (nextRank != -1)){
+                int nextPosition = hot.getCandidateByAvailability(k, nextSection, nextRank);
+                int nextNode = hot.getCandidate(k, nextSection, nextPosition);
+                chainAvailability += sectionFactor[nextSection] * hot.getAvailability(nextNode);
+                workspace.sectionLogFailure[nextSection] += hot.getLogFailure(nextNode);
+                sectionAvailability[nextSection] = getAvailabilityFromLogFailure(workspace.sectionLogFailure[nextSection]);
+                sectionFactor[nextSection] = getSectionFactor(REQUIRED_AVAIL, sectionAvailability[nextSection]);
+                workspace.removeCandidate(nextSection, nextRank);
+                coeff(nextSection, nextPosition) = 0;
+                sectionNodes(nextSection, nbSectionNodes[nextSection]++) = nextPosition;
             }
+            /* If not, stop */
+            else{
+                STOP = true;
+            }
+        }
+        
+        double lhs = 0.0;
+        for (int i = 0; i < hot.getNbSections(k); i++){
+            for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                lhs += (coeff(i, p)*xSol(k, i, p));
+            }
+        }
 
-            if (lhs < 1){
-                IloExpr expr(env);
-                for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                        int v = data.getNodeId(n);
-                        if (coeff[i][v] == 1){
-                            expr += x[k][i][v];
-                        }
-                    }
-                }
-                std::string name = "availabilityCut";
+        return (lhs < 1);
+    }
+    return false;
+}
+
+/* Separates the availability cover inequalities of demand k with the knapsack DPs of the cover separator. */
+bool Callback::knapsackSeparationOfAvailabilityConstraints(const int k, const IloNum3DMatrix& xSol, Workspace& workspace)
+{
+    double lhs = workspace.cover.separate(k, xSol, workspace.coeff);
+    return (lhs < 1);
+}
 
-                IloRange cut(env, 1, expr, IloInfinity, name.c_str());
-                //std::cout << "Adding user cut: " << std::endl;
-                context.addUserCut(cut, IloCplex::UseCutFilter, IloFalse);
-                expr.end();
-                incrementAvailabilityCutsHeuristic();
+/* Buffers the cut stored in the workspace coefficients for demand k. */
+void Callback::bufferAvailabilityCut(const int k, const IloNum3DMatrix& xSol, Workspace& workspace)
+{
+    const FlatMatrix<int>& coeff = workspace.coeff;
+    std::vector<int>& support = workspace.support;
+    support.clear();
+    double lhs = 0.0;
+    for (int i = 0; i < hot.getNbSections(k); i++){
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            if (coeff(i, p) == 1){
+                support.push_back(x.index(k, i, p));
+                lhs += xSol(k, i, p);
             }
         }
     }
+    workspace.bufferCut(k, lhs);
 }
 
-void Callback::computeDeltaAvailability(const double CHAIN_AVAIL, std::vector< std::vector<double> >& deltaAvail, const std::vector< double >& sectionAvail, const std::vector< std::vector<int> >& coeff){
-    for (unsigned int i = 0; i < sectionAvail.size(); i++){
-        for (unsigned int v = 0; v < coeff[i].size(); v++){
-            /* If node is already placed, forbid inclusion */
-            if (coeff[i][v] == 0){
-                deltaAvail[i][v] = 10.0;
-            }
-            else{
-                double newSectionAvail = (1.0 - ((1.0 - sectionAvail[i])*(1.0 - data.getNode(v).getAvailability())));
-                double newChainAvail = (CHAIN_AVAIL / sectionAvail[i])*newSectionAvail;
-                deltaAvail[i][v] = newChainAvail - CHAIN_AVAIL;
-            }
+/* Adds the c-th cut buffered in buffer and records it in the pool. */
+double Callback::addAvailabilityCut(const Context &context, Workspace& workspace, const Workspace& buffer, const int c)
+{
+    const int k = buffer.cutDemand[c];
+    std::vector<int>& support = workspace.support;
+    support.assign(buffer.cutSupport.begin() + buffer.cutOffset[c], buffer.cutSupport.begin() + buffer.cutOffset[c+1]);
+    /* The cut is violated by the current relaxation: even if the pool holds it, CPLEX filtered or purged it since, so it is added again. */
+    pool.insert(CutPool::USER_CUT, k, support);
+
+    IloExpr expr(env);
+    for (unsigned int n = 0; n < support.size(); n++){
+        expr += xArray[support[n]];
+    }
+    IloRange cut(env, 1, expr, IloInfinity);
+    /* Names only serve the LP export, like the names of the model. */
+    if (!data.getInput().getLpFile().empty()){
+        cut.setName("availabilityCut");
+    }
+    //std::cout << "Adding user cut: " << std::endl;
+    context.addUserCut(cut, IloCplex::UseCutFilter, IloFalse);
+    expr.end();
+    incrementAvailabilityCutsHeuristic(workspace.thread, k);
+    return (support.size() > 0) ? (1.0 - buffer.cutLhs[c]) / std::sqrt((double)support.size()) : 0.0;
+}
+
+/* Returns the chain availability gained per unit of node availability placed on a section. */
+double Callback::getSectionFactor(const double CHAIN_AVAIL, const double sectionAvail) const
+{
+    return CHAIN_AVAIL * (1.0 - sectionAvail) / sectionAvail;
+}
+
+/* Fills the candidate tree of the i-th section of demand k with its candidates not yet placed, by increasing availability. */
+void Callback::buildCandidates(const int k, const int i, const IloNum3DMatrix& xSol, Workspace& workspace) const
+{
+    for (int q = 0; q < hot.getNbCandidates(k, i); q++){
+        const int p = hot.getCandidateByAvailability(k, i, q);
+        if (workspace.coeff(i, p) == 1){
+            workspace.candidateWeight(i, q) = (xSol(k, i, p) + EPS) / hot.getAvailability(hot.getCandidate(k, i, p));
+        }
+        else{
+            workspace.candidateWeight(i, q) = -1.0;
         }
     }
+    workspace.buildCandidates(i);
 }
 
 void Callback::addLazyConstraints(const Context &context)
 {
     try {
         /* Get current integer solution */
-        IloNum3DMatrix xSol = getIntegerSolution(context); 
+        Workspace& workspace = getWorkspace(context);
+        getIntegerSolution(context, workspace);
+        IloNum3DMatrix& xSol = workspace.xSol;
+        std::vector<MapAvailability>& sectionAvailability = workspace.sectionMap;
 
         /* Check VNF placement availability for each demand */
-        for (int k = 0; k < data.getNbDemands(); k++){
+        for (int k = 0; k < hot.getNbDemands(); k++){
             
-            /* Compute sections availability and sort them by increasing order */
-            std::vector<MapAvailability> sectionAvailability = getAvailabilitiesOfSections(k, xSol);
-            std::sort(sectionAvailability.begin(), sectionAvailability.end(), compareAvailability);
-
-            /* Find smallest subset of sections violating the SFC availability. */
-            const double REQUIRED_AVAIL = data.getDemand(k).getAvailability(); 
-            double chainAvailability = 1.0;
-            int index = 0;
-            int nbSelectedSections = 0;
-            while ((chainAvailability >= REQUIRED_AVAIL) && (index < data.getDemand(k).getNbVNFs())){
-                chainAvailability *= sectionAvailability[index].availability;
-                nbSelectedSections++;
-                index++;
+            /* A demand whose placements did not change and was feasible is still feasible. */
+            const bool unchanged = isSamePlacement(k, workspace);
+            if (unchanged && !workspace.candidateViolated[k]){
+                stats.addSkippedDemand(workspace.thread, CallbackStats::CANDIDATE);
+                continue;
+            }
+
+            /* Compute sections availability, or reuse them if the placements did not change, and check the whole chain, in section order, with the same kernel as the fractional separation. */
+            if (unchanged){
+                getCachedAvailabilitiesOfSections(k, workspace);
+            }
+            else{
+                getAvailabilitiesOfSections(k, xSol, sectionAvailability);
+                for (int i = 0; i < hot.getNbSections(k); i++){
+                    workspace.candidateLogFailure[hot.getSection(k, i)] = sectionAvailability[i].logFailure;
+                }
+            }
+            const double LOG_REQUIRED_AVAIL = hot.getLogRequiredAvailability(k); 
+            workspace.sectionLogAvailability.resize(hot.getNbSections(k));
+            for (int i = 0; i < hot.getNbSections(k); i++){
+                workspace.sectionLogAvailability[i] = sectionAvailability[i].logAvailability;
             }
-            /* If such subset is found, add lazy constraint. */
-            if (chainAvailability < REQUIRED_AVAIL){
-                //std::cout << "\t SFC: " << k << ", Availability:" << chainAvailability << ", Requested availability: " << data.getDemand(k).getAvailability() <<  std::endl;
-                //std::cout << "Reject candidate solution with " << nbSelectedSections << "sections selected out of " << data.getDemand(k).getNbVNFs() << ".  " << std::endl;
+            workspace.candidateViolated[k] = (data.getChainLogAvailability(workspace.sectionLogAvailability) < LOG_REQUIRED_AVAIL);
+            if (workspace.candidateViolated[k]){
+                //std::cout << "\t SFC: " << k << ", Requested availability: " << hot.getRequiredAvailability(k) <<  std::endl;
+
+                /* Sort sections by increasing availability and find smallest subset of sections violating the SFC availability. */
+                std::sort(sectionAvailability.begin(), sectionAvailability.end(), compareAvailability);
+                double chainLogAvailability = 0.0;
+                int nbSelectedSections = 0;
+                while ((chainLogAvailability >= LOG_REQUIRED_AVAIL) && (nbSelectedSections < hot.getNbSections(k))){
+                    chainLogAvailability += sectionAvailability[nbSelectedSections].logAvailability;
+                    nbSelectedSections++;
+                }
+                //std::cout << "Reject candidate solution with " << nbSelectedSections << "sections selected out of " << hot.getNbSections(k) << ".  " << std::endl;
                 
                 /* Try to lift the separating inequality */
-                lift(xSol[k], REQUIRED_AVAIL, sectionAvailability, nbSelectedSections);
+                workspace.lifter.lift(k, data.getInput().getLiftingMode(), LOG_REQUIRED_AVAIL, nbSelectedSections, xSol, sectionAvailability);
 
-                /* Build inequality. */
-                IloExpr exp(env);
+                /* Build inequality. The candidate is rejected even if the pool already holds it. */
+                std::vector<int>& support = workspace.support;
+                support.clear();
                 for (int s = 0; s < nbSelectedSections; ++s){
                     int i = sectionAvailability[s].section;
-                    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                        int v = data.getNodeId(n);
-                        if (xSol[k][i][v] < 1 - EPS){
-                            exp += x[k][i][v];
+                    for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                        if (xSol(k, i, p) < 1 - EPS){
+                            support.push_back(x.index(k, i, p));
                         }
                     }
                 }
+                std::sort(support.begin(), support.end());
+                pool.insert(CutPool::LAZY_CONSTRAINT, k, support);
+
+                IloExpr exp(env);
+                for (unsigned int n = 0; n < support.size(); n++){
+                    exp += xArray[support[n]];
+                }
                 IloRange cut(env, 1.0, exp, IloInfinity);
                 //std::cout << "Adding lazy constraint: " << cut << std::endl;
                 context.rejectCandidate(cut);
                 exp.end();
-                incrementLazyConstraints();
+                incrementLazyConstraints(workspace.thread, k);
             }
         }
     }
@@ -255,90 +478,85 @@ void Callback::addLazyConstraints(const Context &context)
     }
 }
 
-void Callback::lift(IloNumMatrix& xSol, const double& availabilityRequired, std::vector<Callback::MapAvailability>& sectionAvailability, const int& nbSections){
-    
-    //std::cout << "LIFTING:" << std::endl;
-    for (int s = 0; s < nbSections; ++s){
-        int i = sectionAvailability[s].section;
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            int v = data.getNodeId(n);
-            /* If the i-th vnf is not placed on node v */
-            if (xSol[i][v] < 1 - EPS){
-                /* Compute the availability obtained if a i-th vnf was placed on node v*/
-                double futureAvailability = 1.0;
-                double futureAvailabilityOfSection = sectionAvailability[s].availability;
-                for (int j = 0; j < nbSections; ++j){
-                    if (s == j){
-                        double newFailureRate = (1.0 - sectionAvailability[j].availability)*(1.0 - data.getNode(v).getAvailability());
-                        futureAvailabilityOfSection = (1.0 - newFailureRate);
-                        futureAvailability *= futureAvailabilityOfSection;
-                    }
-                    else{
-                        futureAvailability *= sectionAvailability[j].availability;
-                    }
-                }
-                //std::cout << "\t Required:" << availabilityRequired << ", Future: " << futureAvailability << std::endl;
-                /* If the availability would still be violated */
-                if (futureAvailability < availabilityRequired){
-                    /* Place vnf */
-                    xSol[i][v] = 1;
-                    sectionAvailability[s].availability = futureAvailabilityOfSection;
-                    //std::cout << "\t Placing additional vnf..." << std::endl;
-                }
-            }
-        }
-    }
+/* Returns the logarithm of the failure probability of the i-th section of demand k in an integer solution. */
+double Callback::getSectionLogFailure(const int& k, const int& i, const IloNum3DMatrix& xSol) const
+{
+    return sumLogFailureMasked(hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i), xSol.section(k, i), hot.getNbCandidates(k, i), 1 - EPS);
 }
 
 double Callback::getAvailabilityOfSection(const int& k, const int& i, const IloNum3DMatrix& xSol) const
 {
-    double failure_prob = 1.0;
-    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-        int v = data.getNodeId(n);
-        if (xSol[k][i][v] >= 1 - EPS){
-            failure_prob *= (1.0 - data.getNode(v).getAvailability());
-        }
-    }
-    double availability = 1.0 - failure_prob;
-    return availability;
+    return getAvailabilityFromLogFailure(getSectionLogFailure(k, i, xSol));
 }
 
 /* Returns the availabilities of the sections of a SFC demand obtained from an integer solution. */
-std::vector<Callback::MapAvailability> Callback::getAvailabilitiesOfSections (const int& k, const IloNum3DMatrix& xSol) const
+void Callback::getAvailabilitiesOfSections (const int& k, const IloNum3DMatrix& xSol, std::vector<MapAvailability>& sectionAvailability) const
 {   
-    std::vector<MapAvailability> sectionAvailability;
-    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+    sectionAvailability.clear();
+    for (int i = 0; i < hot.getNbSections(k); i++){
         MapAvailability entry;
         entry.section = i;
-        entry.availability = getAvailabilityOfSection(k,i, xSol);
+        entry.logFailure = getSectionLogFailure(k, i, xSol);
+        entry.availability = getAvailabilityFromLogFailure(entry.logFailure);
+        entry.logAvailability = getLogAvailabilityFromLogFailure(entry.logFailure);
         sectionAvailability.push_back(entry);
     }
-    return sectionAvailability;
 }
 
-IloNum3DMatrix Callback::getIntegerSolution(const Context &context) const
+/* Fills the workspace section availabilities of demand k from the log failures cached by the thread. */
+void Callback::getCachedAvailabilitiesOfSections (const int& k, Workspace& workspace) const
+{
+    workspace.sectionMap.clear();
+    for (int i = 0; i < hot.getNbSections(k); i++){
+        MapAvailability entry;
+        entry.section = i;
+        entry.logFailure = workspace.candidateLogFailure[hot.getSection(k, i)];
+        entry.availability = getAvailabilityFromLogFailure(entry.logFailure);
+        entry.logAvailability = getLogAvailabilityFromLogFailure(entry.logFailure);
+        workspace.sectionMap.push_back(entry);
+    }
+}
+
+/* Returns true if the placements of demand k did not change since the thread last checked it; otherwise records them. 
+   Skipping a demand accepts the incumbent, so a fingerprint collision must not be enough: matching fingerprints are confirmed on the placements. */
+bool Callback::isSamePlacement (const int& k, Workspace& workspace) const
 {
-    /* Initialize solution */
-    IloNum3DMatrix xSol;
-    xSol.resize(data.getNbDemands());
-    for (int k = 0; k < data.getNbDemands(); k++){
-        xSol[k].resize(data.getDemand(k).getNbVNFs());
-        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            xSol[k][i].resize(lemon::countNodes(data.getGraph()));
+    const IloNum3DMatrix& xSol = workspace.xSol;
+    std::vector<char>& placement = workspace.candidatePlacement;
+    uint64_t fingerprint = fingerprintMask(xSol.data() + xSol.begin(k), xSol.end(k) - xSol.begin(k), 1 - EPS);
+    if (fingerprint == workspace.candidateFingerprint[k]){
+        bool same = true;
+        for (int n = xSol.begin(k); n < xSol.end(k) && same; n++){
+            same = (placement[n] == (xSol[n] >= 1 - EPS));
         }
+        if (same){
+            return true;
+        }
+    }
+    workspace.candidateFingerprint[k] = fingerprint;
+    for (int n = xSol.begin(k); n < xSol.end(k); n++){
+        placement[n] = (xSol[n] >= 1 - EPS);
+    }
+    return false;
+}
+
+/* Returns the workspace of the calling thread. */
+Workspace& Callback::getWorkspace(const Context &context)
+{
+    int thread = (int)context.getIntInfo(IloCplex::Callback::Context::Info::ThreadId);
+    if (thread < 0 || thread >= (int)workspaces.size()){
+        throw IloCplex::Exception(-1, "ERROR: Callback invoked from an unexpected thread !");
     }
+    return workspaces[thread];
+}
 
+void Callback::getIntegerSolution(const Context &context, Workspace& workspace)
+{
     /* Fill solution matrix */
     if (context.getId() == Context::Id::Candidate){
         if (context.isCandidatePoint()) {
-            for (int k = 0; k < data.getNbDemands(); k++){
-                for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                        int v = data.getNodeId(n);
-                        xSol[k][i][v] = context.getCandidatePoint(x[k][i][v]);
-                    }
-                }
-            }
+            context.getCandidatePoint(xArray, workspace.xValues);
+            copySolution(workspace);
         }
         else{
             throw IloCplex::Exception(-1, "ERROR: Unbounded solution within callback !");
@@ -347,81 +565,70 @@ IloNum3DMatrix Callback::getIntegerSolution(const Context &context) const
     else{
         throw IloCplex::Exception(-1, "ERROR: Trying to get integer solution while not in candidate context !");
     }
-
-    /* Return solution matrix */
-    return xSol;
 }
 
-IloNum3DMatrix Callback::getFractionalSolution(const Context &context) const
+void Callback::getFractionalSolution(const Context &context, Workspace& workspace)
 {
-    /* Initialize solution */
-    IloNum3DMatrix xSol;
-    xSol.resize(data.getNbDemands());
-    for (int k = 0; k < data.getNbDemands(); k++){
-        xSol[k].resize(data.getDemand(k).getNbVNFs());
-        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            xSol[k][i].resize(lemon::countNodes(data.getGraph()));
-        }
-    }
-
     /* Fill solution matrix */
     if (context.getId() == Context::Id::Relaxation){
-        for (int k = 0; k < data.getNbDemands(); k++){
-            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                    int v = data.getNodeId(n);
-                    xSol[k][i][v] = context.getRelaxationPoint(x[k][i][v]);
-                }
-            }
-        }
+        context.getRelaxationPoint(xArray, workspace.xValues);
+        copySolution(workspace);
     }
     else{
        throw IloCplex::Exception(-1, "ERROR: Trying to get fractional solution while not in relaxation context !");
     }
-    
-    /* Return solution matrix */
-    return xSol;
 }
 
+/* Copies the values returned by CPLEX into the solution, which is stored in the same order. */
+void Callback::copySolution(Workspace& workspace) const
+{
+    for (std::size_t n = 0; n < workspace.xSol.size(); n++){
+        workspace.xSol[n] = workspace.xValues[(IloInt)n];
+    }
+}
 
 const bool Callback::isIntegerAssignment(const int& k, const IloNum3DMatrix& xSol) const{
-    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            int v = data.getNodeId(n);
-            if ((xSol[k][i][v] >= EPS)  && (xSol[k][i][v] <= 1 - EPS)){
-                return false;
-            }
+    for (int n = xSol.begin(k); n < xSol.end(k); n++){
+        if ((xSol[n] >= EPS)  && (xSol[n] <= 1 - EPS)){
+            return false;
         }
     }
     return true;
 }
 
 
-void Callback::incrementLazyConstraints()
+/* Recording only touches the calling thread's shard, so no lock is needed. */
+void Callback::incrementLazyConstraints(const int thread, const int k)
+{
+    stats.addLazyConstraint(thread, k);
+}
+
+void Callback::incrementAvailabilityCutsHeuristic(const int thread, const int k)
 {
-    thread_flag.lock();
-    ++nbLazyConstraints;
-    //std::cout << "Nb lazy constraints: " << nbLazyConstraints << std::endl;
-    thread_flag.unlock();
+    stats.addUserCut(thread, k);
 }
 
-void Callback::incrementAvailabilityCutsHeuristic()
+void Callback::incrementTime(const int thread, const CallbackStats::ContextType type, const IloNum time)
 {
-    thread_flag.lock();
-    ++nb_cuts_avail_heuristic;
-    //std::cout << "Nb user cuts: " << nb_cuts_avail_heuristic << std::endl;
-    thread_flag.unlock();
+    stats.addInvocation(thread, type, time);
 }
 
-void Callback::incrementTime(const IloNum time)
+/****************************************************************************************/
+/*										Destructor  									*/
+/****************************************************************************************/
+Callback::~Callback()
 {
-    thread_flag.lock();
-    timeAll += time;
-    //std::cout << "Nb lazy constraints: " << nbLazyConstraints << std::endl;
-    thread_flag.unlock();
+    for (unsigned int t = 0; t < workspaces.size(); t++){
+        workspaces[t].end();
+    }
+    for (unsigned int w = 0; w < workerSpaces.size(); w++){
+        workerSpaces[w].end();
+    }
+    xArray.end();
+    heuristicVars.end();
 }
 
-bool compareAvailability(Callback::MapAvailability a, Callback::MapAvailability b)
+bool compareAvailability(MapAvailability a, MapAvailability b)
 {
     return (a.availability < b.availability);
 }
\ No newline at end of file
@@ -7,7 +7,8 @@
 
 /*** C++ Libraries ***/
 #include <thread>
-#include <mutex>
+#include <atomic>
+#include <memory>
 
 /*** CPLEX Libraries ***/
 #include <ilcplex/ilocplex.h>
@@ -15,6 +16,12 @@ ILOSTLBEGIN
 
 /*** Own Libraries ***/
 #include "../instance/data.hpp"
+#include "../tools/matrix.hpp"
+#include "workspace.hpp"
+#include "stats.hpp"
+#include "policy.hpp"
+#include "cutpool.hpp"
+#include "../tools/workerpool.hpp"
 
 /****************************************************************************************/
 /*										TYPEDEFS										*/
@@ -23,15 +30,11 @@ ILOSTLBEGIN
 /*** CPLEX ***/	
 typedef std::vector<IloNumVar>          IloNumVarVector;
 typedef std::vector<IloNumVarVector>    IloNumVarMatrix;
-typedef std::vector<IloNumVarMatrix>    IloNumVar3DMatrix;
-typedef std::vector<IloNumVar3DMatrix>  IloNumVar4DMatrix;
-typedef std::vector<IloNumVar4DMatrix>  IloNumVar5DMatrix;
+typedef RaggedMatrix<IloNumVar>         IloNumVar3DMatrix;
 
 typedef std::vector<IloNum>             IloNumVector;
 typedef std::vector<IloNumVector>       IloNumMatrix;
-typedef std::vector<IloNumMatrix>       IloNum3DMatrix;
-typedef std::vector<IloNum3DMatrix>     IloNum4DMatrix;
-typedef std::vector<IloNum4DMatrix>     IloNum5DMatrix;
+typedef RaggedMatrix<IloNum>            IloNum3DMatrix;
 
 typedef IloCplex::Callback::Context     Context;
 
@@ -40,6 +43,7 @@ typedef IloCplex::Callback::Context     Context;
 /****************************************************************************************/
 #define EPS 1e-4 // Tolerance, about float precision
 #define EPSILON 1e-6 // Tolerance, about float precision
+#define SEPARATION_CHUNK_SIZE 8 // Number of demands taken at once by a separation worker
 
 
 
@@ -55,17 +59,27 @@ private:
     /*** General variables ***/
     const IloEnv&   env;    /**< IBM environment **/
     const Data&     data;   /**< Data read in data.hpp **/
+    const HotData&  hot;    /**< Contiguous view of the data used in the separation loops **/
 
 
     /*** LP data ***/
 	const IloNumVar3DMatrix&    x;          /**< VNF assignement variables **/
+    const IloNumVarMatrix&      y;          /**< VNF placement variables **/
+    IloNumVarArray              xArray;     /**< The same variables in a single array, in the storage order of x. Used to query a whole point at once. **/
+    IloNumVarArray              heuristicVars; /**< The x variables, in the storage order of x, followed by the y variables. Used to post heuristic solutions. **/
 
 
     /*** Manage execution and control ***/
-    std::mutex  thread_flag;                /**< A mutex for synchronizing multi-thread operations. **/
-    int         nb_cuts_avail_heuristic;    /**< Number of availability cuts added through heuristic procedure. **/
-    int         nbLazyConstraints;          /**< Number of lazy constraints added. **/
-    IloNum      timeAll;                    /**< Total time spent on callback. **/
+    CallbackStats   stats;                  /**< Counters of the callback, sharded by thread. **/
+    SeparationPolicy policy;                /**< Decides when fractional solutions are separated. **/
+    CutPool         pool;                   /**< The cuts separated so far, shared by all threads. **/
+
+    /*** Per-thread scratch memory ***/
+    std::vector<Workspace>      workspaces; /**< Workspace of each thread, indexed by CPLEX thread id. **/
+
+    /*** Parallel separation ***/
+    std::unique_ptr<WorkerPool> workers;    /**< Threads separating the demands of a single invocation, or null if separation is sequential. **/
+    std::vector<Workspace>      workerSpaces; /**< Scratch workspace of each separation worker. They hold no solution and buffer the cuts found. **/
 
 
 public:
@@ -73,18 +87,8 @@ public:
 	/****************************************************************************************/
 	/*										Constructors									*/
 	/****************************************************************************************/
-    /** Constructor. Initializes callback variables. **/
-	Callback(const IloEnv& env, const Data& data, const IloNumVar3DMatrix& x);
-
-
-    /****************************************************************************************/
-	/*									Auxliary Structs     								*/
-	/****************************************************************************************/
-    /** Stores the section id and its availability. Used for the separation of integer solutions. **/
-    struct MapAvailability { 
-        int section;
-        double availability; 
-    }; 
+    /** Constructor. Initializes callback variables. @param x The VNF assignment variables. @param y The VNF placement variables. @param nbThreads The maximum number of threads CPLEX may invoke the callback from. **/
+	Callback(const IloEnv& env, const Data& data, const IloNumVar3DMatrix& x, const IloNumVarMatrix& y, const int nbThreads);
 
 
 	/****************************************************************************************/
@@ -96,78 +100,120 @@ public:
     /** Solves the separation problems for a given fractional solution. @note Should only be called within relaxation context.**/
 	void            addUserCuts             (const Context& context); 
     
+    /** Rounds the current fractional solution into a feasible placement and posts it as a heuristic solution if it beats the incumbent. @param workspace The calling thread's workspace, holding the current solution. **/
+    void            postRoundedSolution     (const Context& context, Workspace& workspace);
+
     /** Solves the separation problems for a given integer solution. @note Should only be called within candidate context.**/
     void            addLazyConstraints      (const Context& context);
     
-    /** Returns the current integer solution. @note Should only be called within candidate context. **/ 
-    IloNum3DMatrix  getIntegerSolution      (const Context &context) const;
+    /** Returns the workspace reserved to the calling thread. **/
+    Workspace&      getWorkspace            (const Context &context);
+
+    /** Fills the workspace solution with the current integer solution, queried with a single call. @note Should only be called within candidate context. **/ 
+    void            getIntegerSolution      (const Context &context, Workspace& workspace);
     
-    /** Returns the current fractional solution. @note Should only be called within relaxation context. **/ 
-    IloNum3DMatrix  getFractionalSolution   (const Context &context) const;
+    /** Fills the workspace solution with the current fractional solution, queried with a single call. @note Should only be called within relaxation context. **/ 
+    void            getFractionalSolution   (const Context &context, Workspace& workspace);
+
+    /** Copies the values returned by CPLEX, one per column, into the workspace solution. **/
+    void            copySolution            (Workspace& workspace) const;
 
 
 	/****************************************************************************************/
 	/*							Availability Separation Methods  							*/
 	/****************************************************************************************/
-    /** Greedly solves the separation problem associated with the availability constraints. **/
-    void heuristicSeparationOfAvailibilityConstraints(const Context &context, const IloNum3DMatrix& xSol);
+    /** Separates availability cuts on the current fractional solution with the algorithm chosen in the parameters. Demands are split among the separation workers when the invocation gets them. Returns the number of cuts added. @param workspace The calling thread's workspace, holding the current solution. @param depth The depth of the current node. **/
+    int separationOfAvailabilityConstraints(const Context &context, Workspace& workspace, const long depth);
+
+    /** Separates the availability constraints of demand k and buffers the cut found, if any. @param owner The calling thread's workspace, holding the current solution and the change detection of demand k. @param scratch The workspace of the worker, receiving the cut. **/
+    void separateDemand(const int k, Workspace& owner, Workspace& scratch);
+
+    /** Adds the cuts buffered in a set of workspaces as user cuts, by increasing demand, and records the round. Returns the number of cuts added. @param workspace The calling thread's workspace. @param scratch The workspaces holding the buffered cuts. @param nbScratch The number of such workspaces. **/
+    int addAvailabilityCuts(const Context &context, Workspace& workspace, Workspace* scratch, const int nbScratch);
 
-    /** Initializes the availability heuristic. **/
-    void initiateHeuristic(const int k, std::vector< std::vector<int> >& coeff, std::vector< std::vector<int> >& sectionNodes, std::vector< double >& sectionAvailability, const IloNum3DMatrix& xSol);
+    /** Greedly solves the separation problem associated with the availability constraints of demand k. Returns true if a violated cut was found; its coefficients are left in the workspace. @param xSol The current solution. @param workspace The scratch workspace. **/
+    bool heuristicSeparationOfAvailibilityConstraints(const int k, const IloNum3DMatrix& xSol, Workspace& workspace);
+
+    /** Looks for a violated availability cover inequality of demand k with the knapsack DPs over discretised log weights. The cut found is not necessarily the most violated one. Returns true if a violated cut was found; its coefficients are left in the workspace. @param xSol The current solution. @param workspace The scratch workspace. **/
+    bool knapsackSeparationOfAvailabilityConstraints(const int k, const IloNum3DMatrix& xSol, Workspace& workspace);
+
+    /** Appends the availability cut stored in the workspace coefficients for demand k to the workspace cut buffer. @param xSol The current solution. **/
+    void bufferAvailabilityCut(const int k, const IloNum3DMatrix& xSol, Workspace& workspace);
+
+    /** Adds the c-th cut buffered in buffer as a user cut and records it in the pool. Cuts the pool already holds are added again, since they are violated by the current relaxation. Returns its efficacy: its violation divided by the norm of its coefficients. @param workspace The calling thread's workspace. **/
+    double addAvailabilityCut(const Context &context, Workspace& workspace, const Workspace& buffer, const int c);
+
+    /** Initializes the availability heuristic for demand k in the workspace buffers. **/
+    void initiateHeuristic(const int k, const IloNum3DMatrix& xSol, Workspace& workspace);
 	
-    /** Computes the availability increment resulted from the instalation of a new vnf. @param CHAIN_AVAIL The chain required availability. @param deltaAvail The matrix to be computed. @param sectionAvail THe current section availabilities. @param coeff The matrix of coefficients storing the possible vnfs to be placed. **/
-    void computeDeltaAvailability(const double CHAIN_AVAIL, std::vector< std::vector<double> >& deltaAvail, const std::vector< double >& sectionAvail, const std::vector< std::vector<int> >& coeff);
-    
-    /** Tries to add new vnf placements to the current solution without changing its availability violation. @param xSol The current solution for a given demand. @param availabilityRequired The SFC required availability. @param sectionAvailability The current section availabilities. @param nbSections The number of sections that can be modified. **/
-    void lift(IloNumMatrix& xSol, const double& availabilityRequired, std::vector<MapAvailability>& sectionAvailability, const int& nbSections);
+    /** Returns the availability increment resulted from the instalation of a new vnf, per unit of availability of the node receiving it. @param CHAIN_AVAIL The chain required availability. @param sectionAvail The current availability of the section. **/
+    double getSectionFactor(const double CHAIN_AVAIL, const double sectionAvail) const;
+
+    /** Fills the greedy candidates of the i-th section of demand k with its candidate nodes not placed yet. @param xSol The current solution. @param workspace The scratch workspace. **/
+    void buildCandidates(const int k, const int i, const IloNum3DMatrix& xSol, Workspace& workspace) const;
 	
 
     /****************************************************************************************/
 	/*							    Integer solution query methods 							*/
 	/****************************************************************************************/
+    /** Returns the logarithm of the failure probability of the i-th section of a SFC demand obtained from an integer solution. @param k The demand id. @param i The section id. @param xSol The current integer solution. **/
+    double getSectionLogFailure (const int& k, const int& i, const IloNum3DMatrix& xSol) const;
+
     /** Returns the availability of the i-th section of a SFC demand obtained from an integer solution. @param k The demand id. @param i The section id. @param xSol The current integer solution. **/
     double getAvailabilityOfSection (const int& k, const int& i, const IloNum3DMatrix& xSol) const;
     
-    /** Returns the availabilities of the sections of a SFC demand obtained from an integer solution. @param k The demand id. @param xSol The current integer solution. **/
-    std::vector<MapAvailability> getAvailabilitiesOfSections (const int& k, const IloNum3DMatrix& xSol) const;
+    /** Fills sectionAvailability with the availabilities of the sections of a SFC demand obtained from an integer solution. @param k The demand id. @param xSol The current integer solution. @param sectionAvailability The vector to be filled. **/
+    void getAvailabilitiesOfSections (const int& k, const IloNum3DMatrix& xSol, std::vector<MapAvailability>& sectionAvailability) const;
+
+    /** Fills the workspace section availabilities of a SFC demand from the log failures the thread cached when it last saw the same placements. @param k The demand id. @param workspace The calling thread's workspace. **/
+    void getCachedAvailabilitiesOfSections (const int& k, Workspace& workspace) const;
+
+    /** Returns true if the placements of a SFC demand are the ones the thread saw when it last checked it. Otherwise, records them and returns false. The fingerprint only filters: on a match, the placements are compared one by one. @param k The demand id. @param workspace The calling thread's workspace. **/
+    bool isSamePlacement (const int& k, Workspace& workspace) const;
     
 
 	/****************************************************************************************/
 	/*								      Query Methods	    	    	    				*/
 	/****************************************************************************************/
     /** Returns the number of user cuts added so far. **/ 
-    const int    getNbUserCuts()           const{ return nb_cuts_avail_heuristic; }
+    const long   getNbUserCuts()           const{ return stats.getNbUserCuts(); }
 
     /** Returns the number of lazy constraints added so far. **/ 
-    const int    getNbLazyConstraints()    const{ return nbLazyConstraints; }
+    const long   getNbLazyConstraints()    const{ return stats.getNbLazyConstraints(); }
 
     /** Returns the total time spent on callback so far. **/ 
-    const IloNum getTime()                 const{ return timeAll; }
+    const IloNum getTime()                 const{ return stats.getTime(); }
+
+    /** Returns the callback statistics. **/ 
+    const CallbackStats& getStats()        const{ return stats; }
+
+    /** Returns the pool of the cuts separated so far. **/ 
+    const CutPool& getCutPool()            const{ return pool; }
 
     /** Checks if all placement variables of a given SFC demand are integers. @param k The demand id. @param xSol The current solution. **/
     const bool isIntegerAssignment (const int& k, const IloNum3DMatrix& xSol) const;
     
 
 	/****************************************************************************************/
-	/*								Thread Protected Methods			    				*/
+	/*								Thread Local Methods			    					*/
 	/****************************************************************************************/
-    /** Increase by one the number of lazy constraints added. **/
-    void incrementLazyConstraints();
-    /** Increase by one the number of availability cuts added through the heuristic procedure. **/
-    void incrementAvailabilityCutsHeuristic();
-    /** Increases the total callback time. @param time The time to be added. **/
-    void incrementTime(const IloNum time);
+    /** Increase by one the number of lazy constraints added. @param thread The calling thread. @param k The demand id. **/
+    void incrementLazyConstraints(const int thread, const int k);
+    /** Increase by one the number of availability cuts added through the heuristic procedure. @param thread The calling thread. @param k The demand id. **/
+    void incrementAvailabilityCutsHeuristic(const int thread, const int k);
+    /** Records an invocation of the callback. @param thread The calling thread. @param type The context. @param time The time spent in the invocation. **/
+    void incrementTime(const int thread, const CallbackStats::ContextType type, const IloNum time);
 
 
 	/****************************************************************************************/
 	/*										Destructors			    						*/
 	/****************************************************************************************/
-    /** Destructor **/
-    ~Callback() {}
+    /** Destructor. Frees the Concert arrays. **/
+    ~Callback();
 
 };
 
 /** Checks if the availability of a is lower than the one of b. **/
-bool compareAvailability(Callback::MapAvailability a, Callback::MapAvailability b);
+bool compareAvailability(MapAvailability a, MapAvailability b);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "coverlifter.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+CoverLifter::CoverLifter(const HotData& hot_) : hot(hot_)
+{
+    int maxSections = 0;
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        maxSections = std::max(maxSections, hot.getNbSections(k));
+    }
+    rank.reserve(maxSections);
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Adds placements to the first nbSections sections of demand k as long as the chain availability stays below the required one. */
+void CoverLifter::lift(const int k, const Lifting_Mode mode, const double logAvailabilityRequired, const int nbSections, RaggedMatrix<IloNum>& xSol, std::vector<MapAvailability>& sectionAvailability)
+{
+    double chainLogAvailability = 0.0;
+    for (int s = 0; s < nbSections; ++s){
+        chainLogAvailability += sectionAvailability[s].logAvailability;
+    }
+
+    /* Places the i-th vnf of the s-th selected section on its p-th candidate node if the availability would still be violated. */
+    auto tryPlacement = [&](const int s, const int p){
+        int i = sectionAvailability[s].section;
+        if (xSol(k, i, p) >= LIFT_PLACED_VALUE){
+            return;
+        }
+        double futureLogFailureOfSection = sectionAvailability[s].logFailure + hot.getCandidateLogFailures()[hot.getFirstColumn(k, i) + p];
+        double futureLogAvailabilityOfSection = getLogAvailabilityFromLogFailure(futureLogFailureOfSection);
+        double futureLogAvailability = chainLogAvailability - sectionAvailability[s].logAvailability + futureLogAvailabilityOfSection;
+        if (futureLogAvailability < logAvailabilityRequired){
+            xSol(k, i, p) = 1;
+            chainLogAvailability = futureLogAvailability;
+            sectionAvailability[s].logFailure = futureLogFailureOfSection;
+            sectionAvailability[s].logAvailability = futureLogAvailabilityOfSection;
+            sectionAvailability[s].availability = getAvailabilityFromLogFailure(futureLogFailureOfSection);
+        }
+    };
+
+    if (mode == LIFTING_AVAILABILITY_ORDER){
+        /* The least available nodes raise the chain availability the least: trying them first, on every section, lifts more variables.
+           The candidates of the selected sections, each one sorted by availability, are merged. */
+        rank.assign(nbSections, 0);
+        while (true){
+            int best = -1;
+            double bestAvailability = 0.0;
+            int bestNode = -1;
+            for (int s = 0; s < nbSections; ++s){
+                const int i = sectionAvailability[s].section;
+                if (rank[s] == hot.getNbCandidates(k, i)){
+                    continue;
+                }
+                const double availability = hot.getCandidateSortedAvailabilities()[hot.getFirstColumn(k, i) + rank[s]];
+                const int node = hot.getCandidate(k, i, hot.getCandidateByAvailability(k, i, rank[s]));
+                if (best == -1 || availability < bestAvailability || (availability == bestAvailability && node < bestNode)){
+                    best = s;
+                    bestAvailability = availability;
+                    bestNode = node;
+                }
+            }
+            if (best == -1){
+                break;
+            }
+            tryPlacement(best, hot.getCandidateByAvailability(k, sectionAvailability[best].section, rank[best]++));
+        }
+    }
+    else{
+        for (int s = 0; s < nbSections; ++s){
+            const int i = sectionAvailability[s].section;
+            for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                tryPlacement(s, p);
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef __coverlifter__hpp
+#define __coverlifter__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <algorithm>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+
+/*** Own Libraries ***/
+#include "../instance/hotdata.hpp"
+#include "../instance/input.hpp"
+#include "../tools/matrix.hpp"
+#include "../tools/availability.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define LIFT_PLACED_VALUE   (1 - 1e-4)  // Placements with a larger value are already part of the solution
+
+/****************************************************************************************/
+/*									Auxiliary Structs     								*/
+/****************************************************************************************/
+/** Stores the section id and its availability. Used for the separation of integer solutions. **/
+struct MapAvailability {
+    int section;
+    double availability;
+    double logFailure;          /**< Logarithm of the section failure probability. **/
+    double logAvailability;     /**< Logarithm of the section availability. **/
+};
+
+
+/****************************************************************************************
+ * This class lifts the lazy availability constraints of a demand. Given an integer
+ * solution and a set of its sections whose chain availability is below the required one,
+ * other placements are added to these sections as long as the chain stays violated:
+ * each of them leaves the cut, which makes it stronger. The chain log availability is
+ * kept up to date, so each trial takes constant time. Placements are tried either section
+ * by section, each one over its candidates by increasing node id, or by increasing node
+ * availability across all the sections, ties going to the lowest node, then to the first
+ * section.
+****************************************************************************************/
+class CoverLifter {
+
+private:
+    const HotData&          hot;            /**< The instance data. **/
+    std::vector<int>        rank;           /**< Rank by increasing availability of the next candidate to try on each section. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+    /** Constructor. @param hot The instance data. **/
+    CoverLifter(const HotData& hot);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Lifts the placements of demand k. @param k The demand id. @param mode The order placements are tried in. @param logAvailabilityRequired The logarithm of the SFC required availability. @param nbSections The number of sections that can be modified: the first ones of sectionAvailability. @param xSol The current integer solution, one value per column, modified for demand k only. @param sectionAvailability The availabilities of the sections of demand k, kept up to date. **/
+    void    lift(const int k, const Lifting_Mode mode, const double logAvailabilityRequired, const int nbSections, RaggedMatrix<IloNum>& xSol, std::vector<MapAvailability>& sectionAvailability);
+};
+
+#endif
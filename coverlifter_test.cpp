@@ -0,0 +1,185 @@
+/****************************************************************************************
+ * Checks the lifting of the lazy availability constraints against a brute-force
+ * recomputation on random instances whose candidate sets are pruned, so that candidate
+ * positions and node ids differ. The reference works on node ids only and recomputes the
+ * chain availability from scratch for every trial.
+****************************************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "../instance/hotdata.hpp"
+#include "../solver/coverlifter.hpp"
+
+#define NB_INSTANCES    2000    // Number of random instances
+#define TIE_MARGIN      1e-9    // Trials this close to the required availability are left out, the two sums may round differently
+
+/* Returns the chain log availability of the selected sections, placed[s][v] telling whether node v is placed on the s-th one. */
+static double getChainLogAvailability(const HotData& hot, const std::vector< std::vector<char> >& placed)
+{
+    double chain = 0.0;
+    for (unsigned int s = 0; s < placed.size(); s++){
+        double logFailure = 0.0;
+        for (int v = 0; v < hot.getNbNodes(); v++){
+            if (placed[s][v]){
+                logFailure += hot.getLogFailure(v);
+            }
+        }
+        chain += getLogAvailabilityFromLogFailure(logFailure);
+    }
+    return chain;
+}
+
+/* Lifts the placements of the selected sections by brute force. Returns false if a trial was too close to call. */
+static bool liftByBruteForce(const HotData& hot, const int k, const Lifting_Mode mode, const std::vector<int>& sections, std::vector< std::vector<char> >& placed)
+{
+    /* The trials, as (availability, node, section) in availability order, or (section, node) otherwise. */
+    std::vector< std::pair<double, std::pair<int, int> > > trials;
+    for (unsigned int s = 0; s < sections.size(); s++){
+        for (int v = 0; v < hot.getNbNodes(); v++){
+            if (hot.isCandidate(k, sections[s], v)){
+                double key = (mode == LIFTING_AVAILABILITY_ORDER) ? hot.getAvailability(v) : (double)s;
+                trials.push_back(std::make_pair(key, std::make_pair(v, (int)s)));
+            }
+        }
+    }
+    std::sort(trials.begin(), trials.end());
+    for (unsigned int n = 0; n < trials.size(); n++){
+        const int v = trials[n].second.first;
+        const int s = trials[n].second.second;
+        if (placed[s][v]){
+            continue;
+        }
+        placed[s][v] = 1;
+        double future = getChainLogAvailability(hot, placed);
+        if (std::fabs(future - hot.getLogRequiredAvailability(k)) < TIE_MARGIN){
+            return false;
+        }
+        if (future >= hot.getLogRequiredAvailability(k)){
+            placed[s][v] = 0;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    srand(7);
+    int nbChecked = 0, nbPruned = 0, nbFailures = 0;
+    for (int it = 0; it < NB_INSTANCES; it++){
+        /* Random instance: small capacities and a placement cost limit prune candidates. */
+        int V = 3 + rand() % 8, F = 1 + rand() % 3, K = 1 + rand() % 4;
+        std::vector<Node> nodes;
+        for (int v = 0; v < V; v++){
+            nodes.push_back(Node(v, "n", 0, 0, 1 + rand() % 4, 0.9 + 0.0999 * (rand() / (double)RAND_MAX)));
+        }
+        std::vector<VNF> vnfs;
+        for (int f = 0; f < F; f++){
+            vnfs.push_back(VNF(f, "f", 1.0, V));
+            for (int v = 0; v < V; v++){
+                vnfs[f].setPlacementCost(v, 1 + rand() % 10);
+            }
+        }
+        std::vector<Demand> demands;
+        for (int k = 0; k < K; k++){
+            double required = 1 - std::pow(10, -(1 + 4 * (rand() / (double)RAND_MAX)));
+            demands.push_back(Demand(k, "d", 0, 1, 10, 1 + rand() % 3, required));
+            int S = 1 + rand() % 4;
+            for (int i = 0; i < S; i++){
+                demands[k].addVNF(rand() % F);
+            }
+        }
+        DelayTable delays;
+        HotData hot(nodes, vnfs, demands, 7.0, delays);
+
+        for (int k = 0; k < K; k++){
+            const Lifting_Mode mode = (rand() % 2) ? LIFTING_AVAILABILITY_ORDER : LIFTING_SEQUENTIAL;
+            /* Random integer solution. As in the candidate solutions met by the callback, every section is placed somewhere. */
+            RaggedMatrix<IloNum> xSol(hot.getChainOffsets(), hot.getCandidateOffsets(), 0.0);
+            bool placeable = true;
+            for (int l = 0; l < K; l++){
+                for (int i = 0; i < hot.getNbSections(l); i++){
+                    if (hot.getNbCandidates(l, i) == 0){
+                        placeable = false;
+                        continue;
+                    }
+                    for (int p = 0; p < hot.getNbCandidates(l, i); p++){
+                        xSol(l, i, p) = (rand() % 4 == 0) ? 1.0 : 0.0;
+                    }
+                    xSol(l, i, rand() % hot.getNbCandidates(l, i)) = 1.0;
+                }
+            }
+            if (!placeable){
+                continue;
+            }
+
+            /* Select sections in random order until the chain is violated. */
+            std::vector<int> order;
+            for (int i = 0; i < hot.getNbSections(k); i++){
+                order.push_back(i);
+            }
+            std::random_shuffle(order.begin(), order.end());
+            std::vector<MapAvailability> sectionAvailability;
+            std::vector< std::vector<char> > placed;
+            std::vector<int> sections;
+            bool pruned = false;
+            for (unsigned int s = 0; s < order.size(); s++){
+                const int i = order[s];
+                MapAvailability entry;
+                entry.section = i;
+                entry.logFailure = 0.0;
+                placed.push_back(std::vector<char>(V, 0));
+                for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                    if (xSol(k, i, p) == 1.0){
+                        entry.logFailure += hot.getLogFailure(hot.getCandidate(k, i, p));
+                        placed.back()[hot.getCandidate(k, i, p)] = 1;
+                    }
+                }
+                entry.logAvailability = getLogAvailabilityFromLogFailure(entry.logFailure);
+                entry.availability = getAvailabilityFromLogFailure(entry.logFailure);
+                sectionAvailability.push_back(entry);
+                sections.push_back(i);
+                pruned = pruned || (hot.getNbCandidates(k, i) < V);
+                if (getChainLogAvailability(hot, placed) < hot.getLogRequiredAvailability(k)){
+                    break;
+                }
+            }
+            if (getChainLogAvailability(hot, placed) >= hot.getLogRequiredAvailability(k)){
+                continue;
+            }
+            if (!liftByBruteForce(hot, k, mode, sections, placed)){
+                continue;
+            }
+
+            RaggedMatrix<IloNum> before = xSol;
+            CoverLifter lifter(hot);
+            lifter.lift(k, mode, hot.getLogRequiredAvailability(k), (int)sections.size(), xSol, sectionAvailability);
+
+            /* The selected sections hold the reference placements, and nothing else changed. */
+            bool good = true;
+            for (int l = 0; l < K; l++){
+                for (int i = 0; i < hot.getNbSections(l); i++){
+                    const int s = (l == k) ? (int)(std::find(sections.begin(), sections.end(), i) - sections.begin()) : -1;
+                    for (int p = 0; p < hot.getNbCandidates(l, i); p++){
+                        if (s >= 0 && s < (int)sections.size()){
+                            good = good && ((xSol(l, i, p) == 1.0) == (placed[s][hot.getCandidate(l, i, p)] == 1));
+                        }
+                        else{
+                            good = good && (xSol(l, i, p) == before(l, i, p));
+                        }
+                    }
+                }
+            }
+            if (!good){
+                std::printf("coverlifter: instance %d, demand %d: the lifted support differs from the brute force\n", it, k);
+                nbFailures++;
+            }
+            nbChecked++;
+            nbPruned += pruned;
+        }
+    }
+    std::printf("coverlifter: %d lifts checked, %d with pruned candidates, %d failures\n", nbChecked, nbPruned, nbFailures);
+    return (nbFailures > 0 || nbPruned == 0) ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+#include "coverseparator.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+CoverSeparator::CoverSeparator(const HotData& hot_) : hot(hot_)
+{
+    items.reserve(hot.getMaxCandidates());
+    itemWeight.reserve(hot.getMaxCandidates());
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Fills items and itemWeight with the candidates of positive value on the i-th section of demand k. */
+void CoverSeparator::collectItems(const int k, const int i, const RaggedMatrix<IloNum>& xSol)
+{
+    items.clear();
+    itemWeight.clear();
+    const IloNum* values = xSol.section(k, i);
+    const double* logFailure = hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i);
+    for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+        if (values[p] > COVER_MIN_VALUE){
+            double weight = -logFailure[p];
+            items.push_back(p);
+            itemWeight.push_back(std::isinf(weight) ? -1 : (int)std::ceil(weight / COVER_NODE_UNIT));
+        }
+    }
+}
+
+/* Solves the 0-1 knapsack over the items for every budget up to maxBudget. Items of infinite weight never fit. */
+void CoverSeparator::solveKnapsack(const int k, const int i, const RaggedMatrix<IloNum>& xSol, const int maxBudget, const bool record)
+{
+    const IloNum* values = xSol.section(k, i);
+    const int width = maxBudget + 1;
+    knapsack.assign(width, 0.0);
+    if (record){
+        keep.assign(items.size() * width, 0);
+    }
+    for (unsigned int j = 0; j < items.size(); j++){
+        int weight = itemWeight[j];
+        if (weight < 0){
+            continue;
+        }
+        double value = values[items[j]];
+        for (int b = maxBudget; b >= weight; b--){
+            if (knapsack[b - weight] + value > knapsack[b]){
+                knapsack[b] = knapsack[b - weight] + value;
+                if (record){
+                    keep[j * width + b] = 1;
+                }
+            }
+        }
+    }
+}
+
+/* Returns the number of chain steps contributed by a section of total node weight b, capped at nbSteps. */
+int CoverSeparator::getSteps(const double b, const double step, const int nbSteps) const
+{
+    if (b <= 0.0){
+        return nbSteps;
+    }
+    double contribution = -getLogAvailabilityFromLogFailure(-b);
+    return (int)std::min((double)nbSteps, std::floor(contribution / step));
+}
+
+/* Looks for a violated cover inequality of demand k, the most violated one over the discretised weights. */
+double CoverSeparator::separate(const int k, const RaggedMatrix<IloNum>& xSol, FlatMatrix<int>& coeff)
+{
+    const int nbSections = hot.getNbSections(k);
+    const double LOG_REQUIRED_AVAIL = hot.getLogRequiredAvailability(k);
+    const double rho = -LOG_REQUIRED_AVAIL;
+    if (!(rho > 0.0) || std::isinf(rho)){
+        return IloInfinity;
+    }
+
+    /* The chain DP needs more than COVER_CHAIN_UNITS steps. A section of weight above maxWeight contributes no step. */
+    const int nbSteps = COVER_CHAIN_UNITS + 1;
+    const double step = rho / COVER_CHAIN_UNITS;
+    const double maxWeight = -std::log(-std::expm1(-step));
+    const int maxBudget = (int)std::ceil(maxWeight / COVER_NODE_UNIT);
+
+    /* Best value of each section for each number of steps. */
+    double totalValue = 0.0;
+    optionValue.assign(nbSections, nbSteps + 1, -1.0);
+    optionBudget.assign(nbSections, nbSteps + 1, 0);
+    for (int i = 0; i < nbSections; i++){
+        collectItems(k, i, xSol);
+        solveKnapsack(k, i, xSol, maxBudget, false);
+        for (int b = 0; b <= maxBudget; b++){
+            int m = getSteps(b * COVER_NODE_UNIT, step, nbSteps);
+            if (knapsack[b] > optionValue(i, m)){
+                optionValue(i, m) = knapsack[b];
+                optionBudget(i, m) = b;
+            }
+        }
+        /* Taking every item, with its exact weight. */
+        double allWeight = 0.0;
+        double allValue = 0.0;
+        for (unsigned int j = 0; j < items.size(); j++){
+            allWeight -= hot.getLogFailure(hot.getCandidate(k, i, items[j]));
+            allValue += xSol(k, i, items[j]);
+        }
+        int m = getSteps(allWeight, step, nbSteps);
+        if (allValue > optionValue(i, m)){
+            optionValue(i, m) = allValue;
+            optionBudget(i, m) = -1;
+        }
+        totalValue += allValue;
+    }
+
+    /* Pick one option per section, reaching nbSteps steps with the best value. */
+    chainValue.assign(nbSections + 1, nbSteps + 1, -1.0);
+    chainOption.assign(nbSections + 1, nbSteps + 1, -1);
+    chainPrevious.assign(nbSections + 1, nbSteps + 1, -1);
+    chainValue(0, 0) = 0.0;
+    for (int j = 0; j < nbSections; j++){
+        for (int m = 0; m <= nbSteps; m++){
+            if (chainValue(j, m) < 0.0){
+                continue;
+            }
+            for (int o = 0; o <= nbSteps; o++){
+                if (optionValue(j, o) < 0.0){
+                    continue;
+                }
+                int next = std::min(nbSteps, m + o);
+                double value = chainValue(j, m) + optionValue(j, o);
+                if (value > chainValue(j+1, next)){
+                    chainValue(j+1, next) = value;
+                    chainOption(j+1, next) = o;
+                    chainPrevious(j+1, next) = m;
+                }
+            }
+        }
+    }
+    if (chainValue(nbSections, nbSteps) < 0.0 || totalValue - chainValue(nbSections, nbSteps) >= 1.0){
+        return IloInfinity;
+    }
+
+    /* Rebuild the cover. */
+    coeff.assign(nbSections, hot.getMaxCandidates(), 1);
+    for (int j = nbSections, m = nbSteps; j > 0; j--){
+        const int i = j - 1;
+        const int budget = optionBudget(i, chainOption(j, m));
+        m = chainPrevious(j, m);
+        collectItems(k, i, xSol);
+        if (budget < 0){
+            for (unsigned int n = 0; n < items.size(); n++){
+                coeff(i, items[n]) = 0;
+            }
+            continue;
+        }
+        solveKnapsack(k, i, xSol, budget, true);
+        for (int n = (int)items.size() - 1, b = budget; n >= 0; n--){
+            if (keep[n * (budget + 1) + b]){
+                coeff(i, items[n]) = 0;
+                b -= itemWeight[n];
+            }
+        }
+    }
+
+    /* Check the cover exactly. */
+    sectionLogFailure.assign(nbSections, 0.0);
+    sectionLogAvailability.assign(nbSections, 0.0);
+    for (int i = 0; i < nbSections; i++){
+        const double* logFailure = hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i);
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            if (coeff(i, p) == 0){
+                sectionLogFailure[i] += logFailure[p];
+            }
+        }
+        sectionLogAvailability[i] = getLogAvailabilityFromLogFailure(sectionLogFailure[i]);
+    }
+    double chainLogAvailability = sumLogValues(sectionLogAvailability.data(), nbSections);
+    if (chainLogAvailability >= LOG_REQUIRED_AVAIL){
+        return IloInfinity;
+    }
+
+    /* Lift: add every other candidate placement that keeps the chain below the required availability. */
+    for (int i = 0; i < nbSections; i++){
+        const double* candidateLogFailure = hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i);
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            if (coeff(i, p) == 1){
+                double logFailure = sectionLogFailure[i] + candidateLogFailure[p];
+                double logAvailability = getLogAvailabilityFromLogFailure(logFailure);
+                double future = chainLogAvailability - sectionLogAvailability[i] + logAvailability;
+                if (future < LOG_REQUIRED_AVAIL){
+                    coeff(i, p) = 0;
+                    sectionLogFailure[i] = logFailure;
+                    sectionLogAvailability[i] = logAvailability;
+                    chainLogAvailability = future;
+                }
+            }
+        }
+    }
+
+    double lhs = 0.0;
+    for (int i = 0; i < nbSections; i++){
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            lhs += (coeff(i, p) * xSol(k, i, p));
+        }
+    }
+    return lhs;
+}
@@ -0,0 +1,90 @@
+#ifndef __coverseparator__hpp
+#define __coverseparator__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+
+/*** Own Libraries ***/
+#include "../instance/hotdata.hpp"
+#include "../tools/matrix.hpp"
+#include "../tools/availability.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define COVER_NODE_UNIT     0.01    // Resolution of the node weights -log(1 - a_v) in the section knapsacks
+#define COVER_CHAIN_UNITS   256     // Number of steps -log(R) is split into in the chain DP
+#define COVER_MIN_VALUE     1e-6    // Placements with a smaller value do not take part in the DP
+
+
+/****************************************************************************************
+ * This class separates the availability cover inequalities of a demand over discretised
+ * log weights. A cover is a set S of (section, node) placements whose chain 
+ * availability is below the required availability R; it yields the cut 
+ * sum_{(i,v) not in S} x(i,v) >= 1, and the most violated one maximizes the value of x 
+ * over S. In log space, a section holding nodes of total weight b = sum -log(1 - a_v) 
+ * contributes c(b) = -log(1 - exp(-b)) to -log(chain availability), and S is a cover 
+ * when the contributions add up to more than -log(R). The problem is solved by two DPs:
+ *  - a knapsack per section, over the nodes with a positive value, whose weights are 
+ *    rounded up to COVER_NODE_UNIT, giving the best value for each weight budget;
+ *  - a DP across sections over the contributions c, rounded down to -log(R) / 
+ *    COVER_CHAIN_UNITS, that picks one budget per section.
+ * Rounding only underestimates the contributions, so every cover found is valid; it is 
+ * checked exactly anyway, then lifted with the remaining nodes. For the same reason, 
+ * covers that are only reached with the exact weights are missed: the cut returned is 
+ * the most violated one of the discretised problem, not necessarily of the exact one, and
+ * a violated cover may be left unfound.
+****************************************************************************************/
+class CoverSeparator {
+
+private:
+    const HotData&          hot;            /**< The instance data. **/
+
+    /*** Section knapsack ***/
+    std::vector<int>        items;          /**< Positions of the candidates with a positive value on the current section. **/
+    std::vector<int>        itemWeight;     /**< Rounded weight of each item. **/
+    std::vector<double>     knapsack;       /**< Best value of a subset of the items for each weight budget. **/
+    std::vector<char>       keep;           /**< keep[j * (budget+1) + b] is 1 if item j is in the best subset of budget b. Used for rebuilding a subset. **/
+
+    /*** Chain DP ***/
+    FlatMatrix<double>      optionValue;    /**< optionValue(i, m): best value on section i with a contribution of m steps, or -1. **/
+    FlatMatrix<int>         optionBudget;   /**< optionBudget(i, m): the weight budget reaching it, or -1 for all the items. **/
+    FlatMatrix<double>      chainValue;     /**< chainValue(j, m): best value on the first j sections with m steps in total, or -1. **/
+    FlatMatrix<int>         chainOption;    /**< chainOption(j, m): option of section j-1 in that solution. **/
+    FlatMatrix<int>         chainPrevious;  /**< chainPrevious(j, m): steps of the first j-1 sections in that solution. **/
+
+    /*** Exact check ***/
+    std::vector<double>     sectionLogFailure;      /**< Logarithm of the failure probability of each section of the cover. **/
+    std::vector<double>     sectionLogAvailability; /**< Logarithm of the availability of each section of the cover. **/
+
+    /** Fills items and itemWeight with the candidates of positive value on the i-th section of demand k. **/
+    void    collectItems(const int k, const int i, const RaggedMatrix<IloNum>& xSol);
+    /** Solves the knapsack over the items for every budget up to maxBudget. Records the choices in keep if asked. **/
+    void    solveKnapsack(const int k, const int i, const RaggedMatrix<IloNum>& xSol, const int maxBudget, const bool record);
+    /** Returns the number of chain steps contributed by a section of total node weight b, capped at nbSteps. **/
+    int     getSteps(const double b, const double step, const int nbSteps) const;
+
+public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+    /** Constructor. @param hot The instance data. **/
+    CoverSeparator(const HotData& hot);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Looks for a violated cover inequality of demand k, the most violated one over the discretised weights. @param k The demand id. @param xSol The current solution, one value per column. @param coeff Filled with the cut coefficients, one per candidate position: 0 for the placements of the cover, 1 otherwise. @return The left-hand side of the cut on xSol, or IloInfinity if no cover was found. **/
+    double  separate(const int k, const RaggedMatrix<IloNum>& xSol, FlatMatrix<int>& coeff);
+};
+
+#endif
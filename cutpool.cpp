@@ -0,0 +1,101 @@
+#include "cutpool.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/** Constructor. **/
+CutPool::CutPool() : size(0)
+{
+    for (int s = 0; s < CUT_POOL_SHARDS; s++){
+        shards.push_back(std::unique_ptr<Shard>(new Shard()));
+        for (int t = 0; t < NB_CUT_TYPES; t++){
+            shards.back()->hits[t] = 0;
+            shards.back()->misses[t] = 0;
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Returns the fingerprint of a cut. It is finalized, so that low bits can pick the shard. */
+uint64_t CutPool::hash(const int k, const std::vector<int>& support)
+{
+    uint64_t h = mixFingerprintWord(FINGERPRINT_SEED, (uint64_t)(uint32_t)k);
+    for (unsigned int n = 0; n < support.size(); n++){
+        h = mixFingerprintWord(h, (uint64_t)(uint32_t)support[n]);
+    }
+    return finalizeFingerprint(h);
+}
+
+/* Looks a cut up and stores it if it is new. */
+bool CutPool::insert(const CutType type, const int k, const std::vector<int>& support)
+{
+    const uint64_t key = hash(k, support);
+    Shard& shard = *shards[key % CUT_POOL_SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto range = shard.index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it){
+        const PooledCut& cut = shard.cuts[it->second];
+        if (cut.lazy == (type == LAZY_CONSTRAINT) && cut.demand == k && cut.support == support){
+            shard.hits[type]++;
+            return false;
+        }
+    }
+    shard.misses[type]++;
+    if (size.load(std::memory_order_relaxed) < CUT_POOL_MAX_SIZE){
+        PooledCut cut;
+        cut.demand = k;
+        cut.lazy = (type == LAZY_CONSTRAINT);
+        cut.support = support;
+        shard.index.insert(std::make_pair(key, (int)shard.cuts.size()));
+        shard.cuts.push_back(cut);
+        size.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/****************************************************************************************/
+/*								      Query Methods	    	    	    				*/
+/****************************************************************************************/
+
+long CutPool::getNbHits(const CutType type) const
+{
+    long total = 0;
+    for (unsigned int s = 0; s < shards.size(); s++){
+        std::lock_guard<std::mutex> guard(shards[s]->lock);
+        total += shards[s]->hits[type];
+    }
+    return total;
+}
+
+long CutPool::getNbMisses(const CutType type) const
+{
+    long total = 0;
+    for (unsigned int s = 0; s < shards.size(); s++){
+        std::lock_guard<std::mutex> guard(shards[s]->lock);
+        total += shards[s]->misses[type];
+    }
+    return total;
+}
+
+/****************************************************************************************/
+/*										Display											*/
+/****************************************************************************************/
+
+/* Displays the size of the pool and its hit rates. */
+void CutPool::print() const
+{
+    const char* names[NB_CUT_TYPES] = { "User cuts", "Lazy constraints" };
+    std::cout << "=> Cut pool ..." << std::endl;
+    std::cout << "\t Cuts stored: " << getSize() << std::endl;
+    for (int t = 0; t < NB_CUT_TYPES; t++){
+        long hits = getNbHits((CutType)t);
+        long lookups = hits + getNbMisses((CutType)t);
+        double rate = (lookups > 0) ? (100.0 * hits) / lookups : 0.0;
+        std::cout << "\t " << names[t] << ": " << lookups << " separated, " << hits << " separated again (" << rate << "%)" << std::endl;
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef __cutpool__hpp
+#define __cutpool__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*** Own Libraries ***/
+#include "../tools/fingerprint.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define CUT_POOL_SHARDS     64          // Number of independently locked parts of the pool
+#define CUT_POOL_MAX_SIZE   1000000     // Largest number of cuts stored; later cuts are still checked but no longer stored
+
+
+/** An availability cut sum_{n in support} x[n] >= 1, where support lists positions in the storage order of x. **/
+struct PooledCut {
+    int                 demand;     /**< The demand the cut was separated for. **/
+    bool                lazy;       /**< True if the cut was added as a lazy constraint, false for a user cut. **/
+    std::vector<int>    support;    /**< Positions of the variables of the cut, in increasing order. **/
+};
+
+
+/************************************************************************************
+ * This class stores the availability cuts separated during the solve, keyed by a hash
+ * of their demand and support. It is shared by all the threads: the pool is split
+ * into shards, each one protected by its own mutex, so threads only wait for each 
+ * other when their cuts fall into the same shard. It counts the cuts separated again,
+ * which CPLEX had filtered or purged meanwhile.
+ ************************************************************************************/
+class CutPool {
+
+public:
+    /** The ways a cut is added. **/
+    enum CutType {
+        USER_CUT = 0,
+        LAZY_CONSTRAINT = 1,
+        NB_CUT_TYPES = 2
+    };
+
+private:
+    /** A part of the pool. **/
+    struct Shard {
+        std::mutex                              lock;                   /**< Protects the shard. **/
+        std::unordered_multimap<uint64_t, int>  index;                  /**< Position in cuts of the cuts with a given hash. **/
+        std::vector<PooledCut>                  cuts;                   /**< The cuts of the shard. **/
+        long                                    hits[NB_CUT_TYPES];     /**< Number of cuts found already in the shard. **/
+        long                                    misses[NB_CUT_TYPES];   /**< Number of cuts not found in the shard. **/
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards; /**< The shards. A cut goes to the shard given by its hash. **/
+    std::atomic<long>                   size;   /**< Number of cuts stored. **/
+
+    /** Returns the hash of a cut. **/
+    static uint64_t hash(const int k, const std::vector<int>& support);
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Builds an empty pool. **/
+    CutPool();
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Looks a cut up and stores it if it is new. User cuts and lazy constraints are looked up separately. Returns true if the cut was not in the pool. A cut found in the pool is only counted: the pool does not know whether CPLEX still uses it. @param type How the cut is added. @param k The demand id. @param support The positions of the cut variables, in increasing order. **/
+    bool    insert      (const CutType type, const int k, const std::vector<int>& support);
+
+    /** Hands every stored cut to the handler, called as handler(const PooledCut&). Must not run concurrently with the solve. **/
+    template <typename CutHandler>
+    void    forEachCut  (CutHandler handler) const;
+
+	/****************************************************************************************/
+	/*								      Query Methods	    	    	    				*/
+	/****************************************************************************************/
+    /** Returns the number of cuts stored. **/
+    long    getSize     () const { return size.load(std::memory_order_relaxed); }
+    /** Returns the number of cuts of a given type found already in the pool, that is, separated again. **/
+    long    getNbHits   (const CutType type) const;
+    /** Returns the number of cuts of a given type not found in the pool. **/
+    long    getNbMisses (const CutType type) const;
+
+	/****************************************************************************************/
+	/*										Display											*/
+	/****************************************************************************************/
+    /** Displays the size of the pool and its hit rates. **/
+    void    print       () const;
+};
+
+/* Hands every stored cut to the handler. */
+template <typename CutHandler>
+void CutPool::forEachCut(CutHandler handler) const
+{
+    for (unsigned int s = 0; s < shards.size(); s++){
+        for (unsigned int c = 0; c < shards[s]->cuts.size(); c++){
+            handler(shards[s]->cuts[c]);
+        }
+    }
+}
+
+#endif
@@ -8,12 +8,25 @@
 Data::Data(const std::string &parameter_file) : params(parameter_file)
 {
 	std::cout << "=> Defining data ..." << std::endl;
-	readNodeFile(params.getNodeFile());
-	readLinkFile(params.getLinkFile());
-	readVnfFile(params.getVnfFile());
-	readDemandFile(params.getDemandFile());
-
-	buildGraph();
+	const std::string& snapshot = params.getSnapshotFile();
+	try {
+		if (snapshot.empty() || !loadSnapshot(snapshot)){
+			readInputFiles();
+			if (!snapshot.empty()){
+				saveSnapshot(snapshot);
+			}
+		}
+		else{
+			buildGraph();
+		}
+	}
+	/* Input errors are reported here, once no reading thread is left. */
+	catch (const std::runtime_error& e) {
+		std::cerr << e.what() << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	buildDelayTable();
+	hotData = HotData(tabNodes, tabVnfs, tabDemands, params.getMaxPlacementCost(), delayTable);
 
 	std::cout << "\t Data was correctly constructed !" << std::endl;
 	
@@ -30,8 +43,7 @@ int Data::getIdFromNodeName(const std::string name) const
         return search->second;
     } 
 	else {
-        std::cerr << "ERROR: Could not find a node with name '"<< name << "'... Abort." << std::endl;
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: Could not find a node with name '" + name + "'... Abort.");
     }
 	int invalid = -1;
 	return invalid;
@@ -39,156 +51,385 @@ int Data::getIdFromNodeName(const std::string name) const
 /* Returns the id from the vnf with the given name. */
 int Data::getIdFromVnfName(const std::string name) const
 {
-	for( const auto& it : hashVnf ) {
-		if (it.first == name){
-			return it.second;
-		}
-    }
-    
-	std::cerr << "ERROR: Could not find a vnf with name '"<< name << "'... Abort." << std::endl;
-	exit(EXIT_FAILURE);
+	auto search = hashVnf.find(name);
+	if (search != hashVnf.end()) {
+		return search->second;
+	}
     
-	return -1;
+	throw std::runtime_error("ERROR: Could not find a vnf with name '" + name + "'... Abort.");
 }
 
 /* Returns the probability that all nodes fail simoustaneously. */
 const double Data::getFailureProb (const std::vector<int>& nodes) const
 {
-    double prob_fail = 1.0;
-    for (unsigned int j = 0; j < nodes.size(); j++){                    
-        int v = nodes[j];
-        prob_fail *= (1.0 - getNode(v).getAvailability());
-    }
-    return prob_fail;
+    return getFailureProb(nodes.data(), (int)nodes.size());
+}
+/* Returns the probability that all nodes fail simoustaneously. */
+const double Data::getFailureProb (const int* nodes, const int nbNodes) const
+{
+    return std::exp(sumLogFailureGathered(hotData.getLogFailures().data(), nodes, nbNodes));
 }
 /* Returns the chain availability based on the availability of each section. */
 const double Data::getChainAvailability (const std::vector<double>& sectionAvail) const
 {
-    double prob = 1.0;
+    double logAvailability = 0.0;
     for (unsigned int i = 0; i < sectionAvail.size(); i++){
-        prob *= sectionAvail[i];
+        logAvailability += std::log(sectionAvail[i]);
     }
-    return prob;
+    return std::exp(logAvailability);
+}
+/* Returns the logarithm of the chain availability based on the log availability of each section. */
+const double Data::getChainLogAvailability (const std::vector<double>& sectionLogAvail) const
+{
+    return sumLogValues(sectionLogAvail.data(), (int)sectionLogAvail.size());
 }
 
 /****************************************************************************************/
 /*										Methods 										*/
 /****************************************************************************************/
 
-/* Reads the node file and fills the set of nodes. */
-void Data::readNodeFile(const std::string filename)
+/* Reads the node, link, vnf and demand files concurrently and builds the network graph. */
+void Data::readInputFiles()
 {
-    if (filename.empty()){
-		std::cerr << "ERROR: A node file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
+	const std::string files[] = { params.getNodeFile(), params.getLinkFile(), params.getVnfFile(), params.getDemandFile() };
+	const std::string types[] = { "node", "link", "vnf", "demand" };
+	for (int n = 0; n < 4; n++){
+		if (files[n].empty()){
+			throw std::runtime_error("ERROR: A " + types[n] + " file MUST be declared in the parameters file.");
+		}
+	}
+	for (int n = 0; n < 4; n++){
+		std::cout << "\t Reading " << files[n] << " ..."  << std::endl;
+	}
+
+	/* Every file is mapped and split into rows by its own task. Every task is waited for before an error is passed on, so that none of them outlives a failure. */
+	TokenizedFile rows[4];
+	std::future<void> tokenized[4];
+	for (int n = 0; n < 4; n++){
+		tokenized[n] = std::async(std::launch::async, [&rows, &files, n]{
+			rows[n] = TokenizedFile(Reader(files[n]));
+		});
 	}
-    std::cout << "\t Reading " << filename << " ..."  << std::endl;
-	Reader reader(filename);
-	/* dataList is a vector of vectors of strings. */
-	/* dataList[0] corresponds to the first line of the document and dataList[0][i] to the i-th word.*/
-	std::vector<std::vector<std::string> > dataList = reader.getData();
-	// skip the first line (headers)
-	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int nodeId = (int)i - 1;
-		std::string nodeName = dataList[i][0];
-		double nodeX = atof(dataList[i][1].c_str());
-		double nodeY = atof(dataList[i][2].c_str());
-		double capacity = atof(dataList[i][3].c_str());
-		double avail = atof(dataList[i][4].c_str());
+	std::exception_ptr error;
+	for (int n = 0; n < 4; n++){
+		try {
+			tokenized[n].get();
+		}
+		catch (...) {
+			if (!error){
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error){
+		std::rethrow_exception(error);
+	}
+
+	/* Names are resolved once the dictionaries they refer to are filled. The graph only depends on nodes and links: it is built while vnfs and demands are read. */
+	readNodes(rows[0]);
+	std::future<void> graphBuilt = std::async(std::launch::async, [this, &rows]{
+		readLinks(rows[1]);
+		buildGraph();
+	});
+	try {
+		readVnfs(rows[2]);
+		readDemands(rows[3]);
+	}
+	catch (...) {
+		error = std::current_exception();
+	}
+	try {
+		graphBuilt.get();
+	}
+	catch (...) {
+		if (!error){
+			error = std::current_exception();
+		}
+	}
+	if (error){
+		std::rethrow_exception(error);
+	}
+}
+
+/* Fills the set of nodes from the rows of the node file. */
+void Data::readNodes(const TokenizedFile& file)
+{
+	for (std::size_t r = 0; r < file.getNbRows(); r++){
+		const RowView row = file.getRow(r);
+		const int nodeId = (int)r;
+		std::string nodeName = row[0].str();
+		double nodeX = row[1].toDouble();
+		double nodeY = row[2].toDouble();
+		double capacity = row[3].toDouble();
+		double avail = row[4].toDouble();
 		this->tabNodes.push_back(Node(nodeId, nodeName, nodeX, nodeY, capacity, avail));
 		hashNode.insert({nodeName, nodeId});
 	}
 }
 
-/* Reads the link file and fills the set of links. */
-void Data::readLinkFile(const std::string filename)
+/* Fills the set of links from the rows of the link file. */
+void Data::readLinks(const TokenizedFile& file)
 {
-    if (filename.empty()){
-		std::cerr << "ERROR: A link file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
-	}
-    std::cout << "\t Reading " << filename << " ..."  << std::endl;
-	Reader reader(filename);
-	/* dataList is a vector of vectors of strings. */
-	/* dataList[0] corresponds to the first line of the document and dataList[0][i] to the i-th word.*/
-	std::vector<std::vector<std::string> > dataList = reader.getData();
-	// skip the first line (headers)
-	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int linkId = (int)i - 1;
-		std::string linkName = dataList[i][0];
-		int source = getIdFromNodeName(dataList[i][1]);
-		int target = getIdFromNodeName(dataList[i][2]);
-		double delay = atof(dataList[i][3].c_str());;
-		double bandwidth = atof(dataList[i][4].c_str());
+	for (std::size_t r = 0; r < file.getNbRows(); r++){
+		const RowView row = file.getRow(r);
+		const int linkId = (int)r;
+		std::string linkName = row[0].str();
+		int source = getIdFromNodeName(row[1].str());
+		int target = getIdFromNodeName(row[2].str());
+		double delay = row[3].toDouble();
+		double bandwidth = row[4].toDouble();
 		this->tabLinks.push_back(Link(linkId, linkName, source, target, delay, bandwidth));
 	}
 }
 
-
-
-/* Reads the vnf file and fills the set of vnfs. */
-void Data::readVnfFile(const std::string filename)
+/* Fills the set of vnfs from the rows of the vnf file. */
+void Data::readVnfs(const TokenizedFile& file)
 {
-    if (filename.empty()){
-		std::cerr << "ERROR: A vnf file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
-	}
-    std::cout << "\t Reading " << filename << " ..."  << std::endl;
-	Reader reader(filename);
-	/* dataList is a vector of vectors of strings. */
-	/* dataList[0] corresponds to the first line of the document and dataList[0][i] to the i-th word.*/
-	std::vector<std::vector<std::string> > dataList = reader.getData();
-	// skip the first line (headers)
-	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int vnfId = (int)i - 1;
-		std::string vnfName = dataList[i][0];
-		double resource_consumption = atof(dataList[i][1].c_str());
-		int nbNodes = dataList[i].size() - 2;
+	for (std::size_t r = 0; r < file.getNbRows(); r++){
+		const RowView row = file.getRow(r);
+		const int vnfId = (int)r;
+		std::string vnfName = row[0].str();
+		double resource_consumption = row[1].toDouble();
+		int nbNodes = row.size() - 2;
 		if (nbNodes != getNbNodes()){
-			std::cerr << "ERROR: Number of nodes in vnf file does not match the node file one.\n"; 
-			exit(EXIT_FAILURE);
+			throw std::runtime_error("ERROR: Number of nodes in vnf file does not match the node file one.");
 		}
 		this->tabVnfs.push_back(VNF(vnfId, vnfName, resource_consumption, nbNodes));
 		hashVnf.insert({vnfName, vnfId});
-		for (unsigned int j = 2; j < dataList[i].size(); j++){
+		for (unsigned int j = 2; j < row.size(); j++){
 			int index = j - 2;
-			tabVnfs[vnfId].setPlacementCost(index, atof(dataList[i][j].c_str()));
+			tabVnfs[vnfId].setPlacementCost(index, row[j].toDouble());
 		}
 	}
 }
 
-/** Reads the demand file and fills the set of demands. @param filename The demand file to be read. **/
-void Data::readDemandFile(const std::string filename)
+/* Fills the set of demands from the rows of the demand file. */
+void Data::readDemands(const TokenizedFile& file)
 {
-    if (filename.empty()){
-		std::cerr << "ERROR: A demand file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
-	}
-    std::cout << "\t Reading " << filename << " ..."  << std::endl;
-	Reader reader(filename);
-	/* dataList is a vector of vectors of strings. */
-	/* dataList[0] corresponds to the first line of the document and dataList[0][i] to the i-th word.*/
-	std::vector<std::vector<std::string> > dataList = reader.getData();
-	// skip the first line (headers)
-	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int demandId = (int)i - 1;
-		std::string demandName = dataList[i][0];
-		int source = getIdFromNodeName(dataList[i][1]);
-		int target = getIdFromNodeName(dataList[i][2]);
-		double latency = atof(dataList[i][3].c_str());
-		double band = atof(dataList[i][4].c_str());
-		double availability = atof(dataList[i][5].c_str());
+	for (std::size_t r = 0; r < file.getNbRows(); r++){
+		const RowView row = file.getRow(r);
+		const int demandId = (int)r;
+		std::string demandName = row[0].str();
+		int source = getIdFromNodeName(row[1].str());
+		int target = getIdFromNodeName(row[2].str());
+		double latency = row[3].toDouble();
+		double band = row[4].toDouble();
+		double availability = row[5].toDouble();
 		this->tabDemands.push_back(Demand(demandId, demandName, source, target, latency, band, availability));
-		std::vector<std::string> list = split(dataList[i][6], ",");
-		for (unsigned int j = 0; j < list.size(); j++){
-			if (!list[j].empty()){
-				int vnfId = getIdFromVnfName(list[j]);
+		if (row.size() > 6){
+			forEachSubToken(row[6], ',', [&](const Token& vnfName){
+				int vnfId = getIdFromVnfName(vnfName.str());
 				tabDemands[demandId].addVNF(vnfId);
-			}
+			});
 		}
 	}
 }
 
+/* Fills the sets of nodes, links, vnfs and demands from a binary snapshot. */
+bool Data::loadSnapshot(const std::string filename)
+{
+	if (!isReadable(filename)){
+		return false;
+	}
+	MappedFile file(filename);
+	const char* base = file.begin();
+	if (file.size() < sizeof(SnapshotHeader)){
+		std::cout << "WARNING: Snapshot " << filename << " is corrupted and will be rebuilt." << std::endl;
+		return false;
+	}
+	const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(base);
+	if (std::strncmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 
+		|| header.version != SNAPSHOT_VERSION || header.endianness != SNAPSHOT_ENDIANNESS){
+		std::cout << "WARNING: Snapshot " << filename << " has an unknown format and will be rebuilt." << std::endl;
+		return false;
+	}
+	if (header.fingerprint != getInputFingerprint(params)){
+		std::cout << "WARNING: Snapshot " << filename << " is outdated and will be rebuilt." << std::endl;
+		return false;
+	}
+	/* Counts larger than the file cannot be right, and would overflow the layout. */
+	if (header.nbChainEntries > file.size() || header.stringsSize > file.size()){
+		std::cout << "WARNING: Snapshot " << filename << " is corrupted and will be rebuilt." << std::endl;
+		return false;
+	}
+	const SnapshotLayout layout(header);
+	if (file.size() != layout.total){
+		std::cout << "WARNING: Snapshot " << filename << " is corrupted and will be rebuilt." << std::endl;
+		return false;
+	}
+
+	const SnapshotNode*   nodes   = reinterpret_cast<const SnapshotNode*>(base + layout.nodes);
+	const SnapshotLink*   links   = reinterpret_cast<const SnapshotLink*>(base + layout.links);
+	const SnapshotVnf*    vnfs    = reinterpret_cast<const SnapshotVnf*>(base + layout.vnfs);
+	const SnapshotDemand* demands = reinterpret_cast<const SnapshotDemand*>(base + layout.demands);
+	const double*         costs   = reinterpret_cast<const double*>(base + layout.placementCost);
+	const int32_t*        chains  = reinterpret_cast<const int32_t*>(base + layout.chains);
+	const char*           strings = base + layout.strings;
+
+	/* Every offset and id is checked before anything is built, so a corrupted file leaves the object untouched. */
+	auto isName = [&header](const uint32_t offset, const uint32_t length){
+		return (uint64_t)offset + length <= header.stringsSize;
+	};
+	auto isNode = [&header](const int32_t v){
+		return v >= 0 && (uint32_t)v < header.nbNodes;
+	};
+	bool valid = true;
+	for (uint32_t v = 0; v < header.nbNodes && valid; v++){
+		valid = isName(nodes[v].nameOffset, nodes[v].nameLength);
+	}
+	for (uint32_t a = 0; a < header.nbLinks && valid; a++){
+		valid = isName(links[a].nameOffset, links[a].nameLength) && isNode(links[a].source) && isNode(links[a].target);
+	}
+	for (uint32_t f = 0; f < header.nbVnfs && valid; f++){
+		valid = isName(vnfs[f].nameOffset, vnfs[f].nameLength);
+	}
+	for (uint32_t k = 0; k < header.nbDemands && valid; k++){
+		const SnapshotDemand& demand = demands[k];
+		valid = isName(demand.nameOffset, demand.nameLength) && isNode(demand.source) && isNode(demand.target)
+				&& demand.chainOffset <= header.nbChainEntries && demand.chainLength <= header.nbChainEntries - demand.chainOffset;
+	}
+	for (uint64_t n = 0; n < header.nbChainEntries && valid; n++){
+		valid = (chains[n] >= 0 && (uint32_t)chains[n] < header.nbVnfs);
+	}
+	if (!valid){
+		std::cout << "WARNING: Snapshot " << filename << " is corrupted and will be rebuilt." << std::endl;
+		return false;
+	}
+	std::cout << "\t Reading " << filename << " ..."  << std::endl;
+
+	const int nbNodes = (int)header.nbNodes;
+	tabNodes.reserve(header.nbNodes);
+	for (int v = 0; v < nbNodes; v++){
+		const SnapshotNode& node = nodes[v];
+		std::string name(strings + node.nameOffset, node.nameLength);
+		tabNodes.push_back(Node(v, name, node.x, node.y, node.capacity, node.availability));
+		hashNode.insert({name, v});
+	}
+	tabLinks.reserve(header.nbLinks);
+	for (int a = 0; a < (int)header.nbLinks; a++){
+		const SnapshotLink& link = links[a];
+		std::string name(strings + link.nameOffset, link.nameLength);
+		tabLinks.push_back(Link(a, name, link.source, link.target, link.delay, link.bandwidth));
+	}
+	tabVnfs.reserve(header.nbVnfs);
+	for (int f = 0; f < (int)header.nbVnfs; f++){
+		const SnapshotVnf& vnf = vnfs[f];
+		std::string name(strings + vnf.nameOffset, vnf.nameLength);
+		tabVnfs.push_back(VNF(f, name, vnf.consumption, nbNodes));
+		hashVnf.insert({name, f});
+		for (int v = 0; v < nbNodes; v++){
+			tabVnfs[f].setPlacementCost(v, costs[(std::size_t)f * nbNodes + v]);
+		}
+	}
+	tabDemands.reserve(header.nbDemands);
+	for (int k = 0; k < (int)header.nbDemands; k++){
+		const SnapshotDemand& demand = demands[k];
+		std::string name(strings + demand.nameOffset, demand.nameLength);
+		tabDemands.push_back(Demand(k, name, demand.source, demand.target, demand.maxLatency, demand.bandwidth, demand.availability));
+		for (uint32_t i = 0; i < demand.chainLength; i++){
+			tabDemands[k].addVNF(chains[demand.chainOffset + i]);
+		}
+	}
+	return true;
+}
+
+/* Writes the sets of nodes, links, vnfs and demands into a binary snapshot. */
+void Data::saveSnapshot(const std::string filename) const
+{
+	std::cout << "\t Writing " << filename << " ..."  << std::endl;
+	SnapshotHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::strncpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	header.endianness = SNAPSHOT_ENDIANNESS;
+	header.fingerprint = getInputFingerprint(params);
+	header.nbNodes = tabNodes.size();
+	header.nbLinks = tabLinks.size();
+	header.nbVnfs = tabVnfs.size();
+	header.nbDemands = tabDemands.size();
+	for (unsigned int k = 0; k < tabDemands.size(); k++){
+		header.nbChainEntries += tabDemands[k].getNbVNFs();
+	}
+
+	/* Build every section in memory. */
+	std::string strings;
+	std::vector<SnapshotNode> nodes(tabNodes.size());
+	for (unsigned int v = 0; v < tabNodes.size(); v++){
+		nodes[v].x = tabNodes[v].getCoordinateX();
+		nodes[v].y = tabNodes[v].getCoordinateY();
+		nodes[v].capacity = tabNodes[v].getCapacity();
+		nodes[v].availability = tabNodes[v].getAvailability();
+		nodes[v].nameOffset = strings.size();
+		nodes[v].nameLength = tabNodes[v].getName().size();
+		strings += tabNodes[v].getName();
+	}
+	std::vector<SnapshotLink> links(tabLinks.size());
+	for (unsigned int a = 0; a < tabLinks.size(); a++){
+		links[a].source = tabLinks[a].getSource();
+		links[a].target = tabLinks[a].getTarget();
+		links[a].delay = tabLinks[a].getDelay();
+		links[a].bandwidth = tabLinks[a].getBandwidth();
+		links[a].nameOffset = strings.size();
+		links[a].nameLength = tabLinks[a].getName().size();
+		strings += tabLinks[a].getName();
+	}
+	std::vector<SnapshotVnf> vnfs(tabVnfs.size());
+	std::vector<double> costs((std::size_t)tabVnfs.size() * tabNodes.size());
+	for (unsigned int f = 0; f < tabVnfs.size(); f++){
+		vnfs[f].consumption = tabVnfs[f].getConsumption();
+		vnfs[f].nameOffset = strings.size();
+		vnfs[f].nameLength = tabVnfs[f].getName().size();
+		strings += tabVnfs[f].getName();
+		std::copy(tabVnfs[f].getPlacementCost().begin(), tabVnfs[f].getPlacementCost().end(), costs.begin() + (std::size_t)f * tabNodes.size());
+	}
+	std::vector<SnapshotDemand> demands(tabDemands.size());
+	std::vector<int32_t> chains;
+	chains.reserve(header.nbChainEntries);
+	for (unsigned int k = 0; k < tabDemands.size(); k++){
+		std::memset(&demands[k], 0, sizeof(SnapshotDemand));
+		demands[k].source = tabDemands[k].getSource();
+		demands[k].target = tabDemands[k].getTarget();
+		demands[k].maxLatency = tabDemands[k].getMaxLatency();
+		demands[k].bandwidth = tabDemands[k].getBandwidth();
+		demands[k].availability = tabDemands[k].getAvailability();
+		demands[k].chainOffset = chains.size();
+		demands[k].chainLength = tabDemands[k].getNbVNFs();
+		demands[k].nameOffset = strings.size();
+		demands[k].nameLength = tabDemands[k].getName().size();
+		strings += tabDemands[k].getName();
+		chains.insert(chains.end(), tabDemands[k].getListOfVNFs().begin(), tabDemands[k].getListOfVNFs().end());
+	}
+	header.stringsSize = strings.size();
+	const SnapshotLayout layout(header);
+
+	/* Write sections at their offsets into a temporary file, then move it in place. */
+	std::string temporary = filename + ".tmp";
+	std::ofstream file(temporary.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file){
+		std::cout << "WARNING: Unable to write snapshot " << filename << "." << std::endl;
+		return;
+	}
+	auto writeAt = [&file](const uint64_t offset, const void* bytes, const std::size_t size){
+		static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		uint64_t current = (uint64_t)file.tellp();
+		file.write(zeros, offset - current);
+		file.write(static_cast<const char*>(bytes), size);
+	};
+	writeAt(0, &header, sizeof(header));
+	writeAt(layout.nodes, nodes.data(), nodes.size() * sizeof(SnapshotNode));
+	writeAt(layout.links, links.data(), links.size() * sizeof(SnapshotLink));
+	writeAt(layout.vnfs, vnfs.data(), vnfs.size() * sizeof(SnapshotVnf));
+	writeAt(layout.demands, demands.data(), demands.size() * sizeof(SnapshotDemand));
+	writeAt(layout.placementCost, costs.data(), costs.size() * sizeof(double));
+	writeAt(layout.chains, chains.data(), chains.size() * sizeof(int32_t));
+	writeAt(layout.strings, strings.data(), strings.size());
+	file.close();
+	if (!file || std::rename(temporary.c_str(), filename.c_str()) != 0){
+		std::cout << "WARNING: Unable to write snapshot " << filename << "." << std::endl;
+		std::remove(temporary.c_str());
+	}
+}
+
 /** Builds the network graph from data stored in tabNodes and tabLinks. **/
 void Data::buildGraph()
 {
@@ -201,33 +442,47 @@ void Data::buildGraph()
 	arcId = new ArcMap(*graph);
 	lemonArcId = new ArcMap(*graph);
 	
-	/* Define nodes */
+	/* Define nodes, indexed by their ids */
+	graph->reserveNode(tabNodes.size());
+	lemonNodes.resize(tabNodes.size(), lemon::INVALID);
 	for (unsigned int i = 0; i < tabNodes.size(); i++){
         Graph::Node n = graph->addNode();
         setNodeId(n, tabNodes[i].getId());
         setLemonNodeId(n, graph->id(n));
+        lemonNodes[tabNodes[i].getId()] = n;
     }
 
 	/* Define arcs */
+	graph->reserveArc(tabLinks.size());
 	for (unsigned int i = 0; i < tabLinks.size(); i++){
         int source = tabLinks[i].getSource();
         int target = tabLinks[i].getTarget();
-        Graph::Node sourceNode = lemon::INVALID;
-        Graph::Node targetNode = lemon::INVALID;
-        for (NodeIt v(getGraph()); v != lemon::INVALID; ++v){
-            if(getNodeId(v) == source){
-                sourceNode = v;
-            }
-            if(getNodeId(v) == target){
-                targetNode = v;
-            }
-        }
-        if (targetNode != lemon::INVALID && sourceNode != lemon::INVALID){
-            Arc a = graph->addArc(sourceNode, targetNode);
+        if (source >= 0 && source < getNbNodes() && target >= 0 && target < getNbNodes()){
+            Arc a = graph->addArc(lemonNodes[source], lemonNodes[target]);
             setLemonArcId(a, graph->id(a));
             setArcId(a, tabLinks[i].getId());
         }
     }
+
+	/* Define the CSR view */
+	staticGraph = StaticGraph(getNbNodes(), tabLinks);
+}
+
+/* Fills the delay table, from the delay file when it matches the topology. */
+void Data::buildDelayTable()
+{
+	if (!params.isLatencyPruning()){
+		return;
+	}
+	const std::string& filename = params.getDelayFile();
+	const uint64_t fingerprint = DelayTable::getTopologyFingerprint(staticGraph);
+	if (filename.empty() || !isReadable(filename) || !delayTable.load(filename, fingerprint)){
+		std::cout << "\t Computing shortest delays..." << std::endl;
+		delayTable.compute(staticGraph, params.getBuildThreads());
+		if (!filename.empty()){
+			delayTable.save(filename, fingerprint);
+		}
+	}
 }
 
 /****************************************************************************************/
@@ -10,17 +10,25 @@
 #include <float.h>
 #include <unordered_map>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <future>
 
 /*** LEMON Libraries ***/     
 #include <lemon/list_graph.h>
 
 /*** Own Libraries ***/  
 #include "input.hpp"
+#include "snapshot.hpp"
+#include "hotdata.hpp"
 #include "../network/demand.hpp"
 #include "../network/node.hpp"
 #include "../network/link.hpp"
 #include "../network/vnf.hpp"
+#include "../network/staticgraph.hpp"
+#include "../network/delaytable.hpp"
 #include "../tools/reader.hpp"
+#include "../tools/availability.hpp"
 
 
 /****************************************************************************************/
@@ -58,6 +66,10 @@ private:
 	NodeMap* 			lemonNodeId;				/**< A map storing the nodes' lemon ids. **/
 	ArcMap* 			arcId;						/**< A map storing the arcs' ids. **/
 	ArcMap* 			lemonArcId;					/**< A map storing the arcs' lemon ids. **/
+	std::vector<Graph::Node> lemonNodes;			/**< The lemon node associated with each node id. **/
+	StaticGraph 		staticGraph;				/**< The network graph in CSR form. **/
+	DelayTable 			delayTable;					/**< Shortest delays between nodes, empty unless latency pruning is on. **/
+	HotData 			hotData;					/**< Contiguous view of the node, vnf and demand fields used in hot loops. **/
 
 	std::unordered_map<std::string, int> hashNode; 	/**< A map for locating node id's from its name. **/
 	std::unordered_map<std::string, int> hashVnf; 	/**< A map for locating vnf id's from its name. **/
@@ -83,6 +95,9 @@ public:
 	const NodeMap& 			 	getLemonNodeIds  () const { return *lemonNodeId; }
 	const ArcMap& 			 	getArcIds    	 () const { return *arcId; }
 	const ArcMap& 			 	getLemonArcIds   () const { return *lemonArcId; }
+	const StaticGraph& 		 	getStaticGraph   () const { return staticGraph; }
+	const DelayTable& 		 	getDelayTable    () const { return delayTable; }
+	const HotData& 			 	getHotData   	 () const { return hotData; }
 	const std::vector<Node>& 	getNodes     	 () const { return tabNodes; }
 	const std::vector<Link>& 	getLinks     	 () const { return tabLinks; }
 	const std::vector<VNF>&  	getVnfs     	 () const { return tabVnfs; }
@@ -100,19 +115,26 @@ public:
 	const int& getLemonNodeId (const Graph::Node& v) const { return (*lemonNodeId)[v]; }
 	const int& getArcId    	  (const Arc& a) 		 const { return (*arcId)[a]; }
 	const int& getLemonArcId  (const Arc& a) 		 const { return (*lemonArcId)[a]; }
+	const Graph::Node& getLemonNode (const int id) 	 const { return lemonNodes[id]; }
 
-	/** Returns the id from the node with the given name. @param name The node name. **/
+	/** Returns the id from the node with the given name. Throws a std::runtime_error if there is none. @param name The node name. **/
 	int	 	   getIdFromNodeName(const std::string name) const;
 
-	/** Returns the id from the vnf with the given name. @param name The vnf name. **/
+	/** Returns the id from the vnf with the given name. Throws a std::runtime_error if there is none. @param name The vnf name. **/
 	int	 	   getIdFromVnfName(const std::string name) const;
 
     /** Returns the probability that a set of nodes fail simoustaneously. @param nodes The set of nodes to fail. **/
     const double getFailureProb(const std::vector<int>& nodes) const;
+
+    /** Returns the probability that a set of nodes fail simoustaneously. @param nodes The first node id of the set. @param nbNodes The number of nodes in the set. **/
+    const double getFailureProb(const int* nodes, const int nbNodes) const;
     
     /** Returns the chain availability based on the availability of each section. @note The chain availability is the product of the availability of its sections. @param sectionAvail The sections availability. **/
     const double getChainAvailability(const std::vector<double>& sectionAvail) const;
 
+    /** Returns the logarithm of the chain availability based on the log availability of each section. @param sectionLogAvail The sections log availability. **/
+    const double getChainLogAvailability(const std::vector<double>& sectionLogAvail) const;
+
 	/****************************************************************************************/
 	/*										Setters											*/
 	/****************************************************************************************/
@@ -126,21 +148,33 @@ public:
 	/*										Methods											*/
 	/****************************************************************************************/
 
-	/** Reads the node file and fills the set of nodes. @param filename The node file to be read. **/
-	void readNodeFile(const std::string filename);
+	/** Reads the node, link, vnf and demand files concurrently and builds the network graph. The four files are mapped and split into rows at the same time; names are then resolved once the nodes, then the vnfs, are known, and the graph is built while vnfs and demands are being read. Input errors are thrown as std::runtime_error, once every reading task is over. **/
+	void readInputFiles();
+
+	/** Fills the set of nodes. @param file The rows of the node file. **/
+	void readNodes(const TokenizedFile& file);
 
-	/** Reads the link file and fills the set of link. @param filename The link file to be read. **/
-	void readLinkFile(const std::string filename);
+	/** Fills the set of links. The nodes must be known. @param file The rows of the link file. **/
+	void readLinks(const TokenizedFile& file);
 
-	/** Reads the vnf file and fills the set of vnfs. @param filename The vnf file to be read. **/
-	void readVnfFile(const std::string filename);
+	/** Fills the set of vnfs. The nodes must be known. @param file The rows of the vnf file. **/
+	void readVnfs(const TokenizedFile& file);
 
-	/** Reads the demand file and fills the set of demands. @param filename The demand file to be read. **/
-	void readDemandFile(const std::string filename);
+	/** Fills the set of demands. The nodes and vnfs must be known. @param file The rows of the demand file. **/
+	void readDemands(const TokenizedFile& file);
 
-	/** Builds the network graph from data stored in tabNodes and tabLinks. **/
+	/** Fills the sets of nodes, links, vnfs and demands from a binary snapshot. Returns false, leaving the object untouched, if the snapshot is missing, corrupted or was built from other input files. @param filename The snapshot file to be read. **/
+	bool loadSnapshot(const std::string filename);
+
+	/** Writes the sets of nodes, links, vnfs and demands into a binary snapshot. @param filename The snapshot file to be written. **/
+	void saveSnapshot(const std::string filename) const;
+
+	/** Builds the network graph from data stored in tabNodes and tabLinks, both as a LEMON graph and in CSR form. Runs in O(|V| + |L|). **/
 	void buildGraph();
 
+	/** Fills the delay table if latency pruning is on: it is read from the delay file if it was computed on the same topology, and computed and written otherwise. **/
+	void buildDelayTable();
+
 	/****************************************************************************************/
 	/*										Display											*/
 	/****************************************************************************************/
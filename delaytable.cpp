@@ -0,0 +1,128 @@
+#include "delaytable.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+
+#include "../tools/fingerprint.hpp"
+#include "../tools/workerpool.hpp"
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Computes every row of the table. Workers take the next source from a shared counter, each with its own heap. */
+void DelayTable::compute(const StaticGraph& graph, const int nbThreads)
+{
+    const int nbNodes = graph.getNbNodes();
+    delays.assign(nbNodes, nbNodes, std::numeric_limits<double>::infinity());
+    WorkerPool workers(std::max(1, std::min(nbThreads, nbNodes)));
+    std::vector< std::vector<std::pair<double, int> > > heaps(workers.getNbWorkers());
+    std::atomic<int> next(0);
+    std::lock_guard<std::mutex> guard(workers.getLock());
+    workers.run([&](const int w){
+        for (int u = next++; u < nbNodes; u = next++){
+            computeFrom(graph, u, heaps[w]);
+        }
+    });
+}
+
+/* Dijkstra from node u with a binary heap of (delay, node) pairs. Entries made obsolete by a shorter delay are skipped when popped. */
+void DelayTable::computeFrom(const StaticGraph& graph, const int u, std::vector<std::pair<double, int> >& heap)
+{
+    double* distance = delays.row(u);
+    std::greater< std::pair<double, int> > closer;
+    heap.clear();
+    distance[u] = 0.0;
+    heap.push_back(std::make_pair(0.0, u));
+    while (!heap.empty()){
+        std::pop_heap(heap.begin(), heap.end(), closer);
+        const double delay = heap.back().first;
+        const int v = heap.back().second;
+        heap.pop_back();
+        if (delay > distance[v]){
+            continue;
+        }
+        for (int a = graph.begin(v); a < graph.end(v); a++){
+            const int w = graph.getTarget(a);
+            if (delay + graph.getDelay(a) < distance[w]){
+                distance[w] = delay + graph.getDelay(a);
+                heap.push_back(std::make_pair(distance[w], w));
+                std::push_heap(heap.begin(), heap.end(), closer);
+            }
+        }
+    }
+}
+
+/* Reads the header, checks it against the current topology, then reads the delays. */
+bool DelayTable::load(const std::string& filename, const uint64_t fingerprint)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file){
+        return false;
+    }
+    DelayTableHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::strncmp(header.magic, DELAY_TABLE_MAGIC, sizeof(header.magic)) != 0 
+        || header.version != DELAY_TABLE_VERSION || header.endianness != DELAY_TABLE_ENDIANNESS){
+        std::cout << "WARNING: Delay table " << filename << " has an unknown format and will be rebuilt." << std::endl;
+        return false;
+    }
+    if (header.fingerprint != fingerprint){
+        std::cout << "WARNING: Delay table " << filename << " is outdated and will be rebuilt." << std::endl;
+        return false;
+    }
+    const int nbNodes = (int)header.nbNodes;
+    FlatMatrix<double> values(nbNodes, nbNodes, 0.0);
+    if (!file.read(reinterpret_cast<char*>(values.row(0)), (std::streamsize)((std::size_t)nbNodes * nbNodes * sizeof(double)))){
+        std::cout << "WARNING: Delay table " << filename << " is corrupted and will be rebuilt." << std::endl;
+        return false;
+    }
+    std::cout << "\t Reading " << filename << " ..."  << std::endl;
+    delays = values;
+    return true;
+}
+
+/* Writes the header and the delays into a temporary file, then moves it in place. */
+void DelayTable::save(const std::string& filename, const uint64_t fingerprint) const
+{
+    std::cout << "\t Writing " << filename << " ..."  << std::endl;
+    DelayTableHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, DELAY_TABLE_MAGIC, sizeof(header.magic));
+    header.version = DELAY_TABLE_VERSION;
+    header.endianness = DELAY_TABLE_ENDIANNESS;
+    header.fingerprint = fingerprint;
+    header.nbNodes = getNbNodes();
+
+    std::string temporary = filename + ".tmp";
+    std::ofstream file(temporary.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file){
+        std::cout << "WARNING: Unable to write delay table " << filename << "." << std::endl;
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (getNbNodes() > 0){
+        file.write(reinterpret_cast<const char*>(delays.row(0)), (std::streamsize)((std::size_t)getNbNodes() * getNbNodes() * sizeof(double)));
+    }
+    file.close();
+    if (!file || std::rename(temporary.c_str(), filename.c_str()) != 0){
+        std::cout << "WARNING: Unable to write delay table " << filename << "." << std::endl;
+        std::remove(temporary.c_str());
+    }
+}
+
+/* The topology is given by the arcs leaving each node, their targets and their delays. */
+uint64_t DelayTable::getTopologyFingerprint(const StaticGraph& graph)
+{
+    uint64_t h = FINGERPRINT_SEED;
+    h = mixFingerprint(h, graph.getOffsets().data(), graph.getOffsets().size() * sizeof(int));
+    h = mixFingerprint(h, graph.getTargets().data(), graph.getTargets().size() * sizeof(int));
+    h = mixFingerprint(h, graph.getDelays().data(), graph.getDelays().size() * sizeof(double));
+    return finalizeFingerprint(h);
+}
@@ -0,0 +1,82 @@
+#ifndef __delaytable__hpp
+#define __delaytable__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*** Own Libraries ***/
+#include "staticgraph.hpp"
+#include "../tools/matrix.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define DELAY_TABLE_MAGIC       "R5GDELAY"  /**< Identifies a delay table file. **/
+#define DELAY_TABLE_VERSION     1           /**< Bumped whenever the file layout changes. **/
+#define DELAY_TABLE_ENDIANNESS  0x01020304  /**< Detects files written on a machine with another byte order. **/
+
+/** Header of a delay table file. It is followed by the nbNodes x nbNodes delays, row by row. **/
+struct DelayTableHeader {
+    char        magic[8];           /**< Always DELAY_TABLE_MAGIC. **/
+    uint32_t    version;            /**< Always DELAY_TABLE_VERSION. **/
+    uint32_t    endianness;         /**< Always DELAY_TABLE_ENDIANNESS. **/
+    uint64_t    fingerprint;        /**< Fingerprint of the topology the table was computed on. **/
+    uint32_t    nbNodes;            /**< Number of nodes. **/
+    uint32_t    padding;            /**< Unused. Keeps the header size a multiple of 8. **/
+};
+
+
+/****************************************************************************************
+ * This class stores the shortest delay between every ordered pair of nodes, computed 
+ * with one Dijkstra per source over the arcs of a StaticGraph. Sources are independent,
+ * so they are split among worker threads. Nodes that cannot be reached are at infinite
+ * delay. As the table only depends on the topology, it can be written to a file and 
+ * read back on later runs, as long as the topology fingerprint did not change.
+****************************************************************************************/
+class DelayTable{
+    private:
+        FlatMatrix<double>  delays;     /**< Entry (u,v) is the shortest delay from node u to node v. **/
+
+        /** Fills row u of the table with a Dijkstra from node u. @param heap Scratch memory for the priority queue. **/
+        void    computeFrom(const StaticGraph& graph, const int u, std::vector<std::pair<double, int> >& heap);
+
+    public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+	/** Constructor. Builds an empty table. **/
+	DelayTable() {}
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+	/** Computes the shortest delays of the given graph. @param graph The network graph. @param nbThreads The number of threads sharing the sources. **/
+	void    compute(const StaticGraph& graph, const int nbThreads);
+
+	/** Reads the table from a file. Returns false, leaving the table unchanged, if the file is missing, corrupted, or was computed on another topology. @param filename The file to be read. @param fingerprint The fingerprint of the current topology. **/
+	bool    load(const std::string& filename, const uint64_t fingerprint);
+
+	/** Writes the table into a file. @param filename The file to be written. @param fingerprint The fingerprint of the topology the table was computed on. **/
+	void    save(const std::string& filename, const uint64_t fingerprint) const;
+
+	/** Returns the fingerprint of a topology: its nodes, arcs and delays. @param graph The network graph. **/
+	static uint64_t getTopologyFingerprint(const StaticGraph& graph);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+	/** Returns true if the table was neither computed nor read. **/
+	bool    isEmpty() 						const { return delays.getNbRows() == 0; }
+	/** Returns the number of nodes. **/
+	int     getNbNodes() 					const { return delays.getNbRows(); }
+	/** Returns the shortest delay from node u to node v, or infinity if v cannot be reached. **/
+	double  getDelay(const int u, const int v) const { return delays(u, v); }
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef __fingerprint__hpp
+#define __fingerprint__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cstdint>
+#include <cstring>
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define FINGERPRINT_SEED    14695981039346656037ULL     // Fingerprint of an empty sequence
+#define FINGERPRINT_PRIME   1099511628211ULL
+
+
+/****************************************************************************************
+ * Fingerprints of sequences of values, used for detecting that a part of a solution did
+ * not change since it was last seen. They are 64-bit FNV-1a hashes over whole words, 
+ * followed by a final mix.
+****************************************************************************************/
+
+/** Returns the final mix of a fingerprint. **/
+inline uint64_t finalizeFingerprint(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/** Mixes a whole word into a fingerprint that is not finalized yet. @param h The fingerprint so far, FINGERPRINT_SEED at first. @param word The word. **/
+inline uint64_t mixFingerprintWord(const uint64_t h, const uint64_t word)
+{
+    return (h ^ word) * FINGERPRINT_PRIME;
+}
+
+/** Mixes a sequence of bytes into a fingerprint that is not finalized yet. @param h The fingerprint so far, FINGERPRINT_SEED at first. @param bytes The bytes. @param size The number of bytes. **/
+inline uint64_t mixFingerprint(uint64_t h, const void* bytes, const std::size_t size)
+{
+    const unsigned char* it = static_cast<const unsigned char*>(bytes);
+    for (std::size_t i = 0; i < size; i++){
+        h = (h ^ it[i]) * FINGERPRINT_PRIME;
+    }
+    return h;
+}
+
+/** Returns the fingerprint of the exact bits of n values. @param values The values. @param n The number of values. **/
+inline uint64_t fingerprintValues(const double* values, const int n)
+{
+    uint64_t h = FINGERPRINT_SEED;
+    for (int j = 0; j < n; j++){
+        uint64_t word;
+        std::memcpy(&word, &values[j], sizeof(word));
+        h = mixFingerprintWord(h, word);
+    }
+    return finalizeFingerprint(h);
+}
+
+/** Returns the fingerprint of the positions of the values that are at least the threshold. @param values The values. @param n The number of values. @param threshold The smallest value of a selected position. **/
+inline uint64_t fingerprintMask(const double* values, const int n, const double threshold)
+{
+    uint64_t h = FINGERPRINT_SEED;
+    for (int j = 0; j < n; j++){
+        if (values[j] >= threshold){
+            h = mixFingerprintWord(h, (uint64_t)j);
+        }
+    }
+    return finalizeFingerprint(h ^ (uint64_t)n);
+}
+
+#endif
@@ -0,0 +1,339 @@
+#include "heuristic.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+HeuristicSolver::HeuristicSolver(const Data& data_) : data(data_), hot(data_.getHotData()), 
+                greedyCost(0.0), nbMoves(0), time(0.0), feasible(false)
+{
+    solution.assignment = RaggedMatrix<IloNum>(hot.getChainOffsets(), hot.getCandidateOffsets(), 0.0);
+    solution.cost = 0.0;
+
+    nodesByCost.resize((std::size_t)hot.getNbVnfs() * hot.getNbNodes());
+    for (int f = 0; f < hot.getNbVnfs(); f++){
+        std::vector<int>::iterator first = nodesByCost.begin() + (std::size_t)f * hot.getNbNodes();
+        for (int v = 0; v < hot.getNbNodes(); v++){
+            first[v] = v;
+        }
+        std::stable_sort(first, first + hot.getNbNodes(), [this, f](const int a, const int b){
+            return hot.getPlacementCost(f, a) < hot.getPlacementCost(f, b);
+        });
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Runs the greedy and the local search. */
+bool HeuristicSolver::run()
+{
+    std::cout << "=> Running placement heuristic ... " << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    nbMoves = 0;
+    feasible = greedy();
+    if (feasible){
+        greedyCost = solution.cost;
+        localSearch();
+
+        /* The cost was updated move by move: sum it again. */
+        solution.cost = 0.0;
+        for (int v = 0; v < hot.getNbNodes(); v++){
+            for (int f = 0; f < hot.getNbVnfs(); f++){
+                solution.cost += solution.installed[(std::size_t)v * hot.getNbVnfs() + f] * hot.getPlacementCost(f, v);
+            }
+        }
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!feasible){
+        std::cout << "\t No feasible placement was found." << std::endl;
+    }
+    return feasible;
+}
+
+/* Assigns the i-th section of demand k to its p-th candidate node. */
+void HeuristicSolver::assign(const int k, const int i, const int p)
+{
+    const int f = hot.getSectionVnf(k, i);
+    const int v = hot.getCandidate(k, i, p);
+    const std::size_t n = (std::size_t)v * hot.getNbVnfs() + f;
+    solution.assignment(k, i, p) = 1.0;
+    if (users[n]++ == 0){
+        solution.installed[n] = 1.0;
+        solution.cost += hot.getPlacementCost(f, v);
+    }
+    nbSectionNodes[hot.getSection(k, i)]++;
+    residualCapacity[v] -= hot.getSectionLoad(k, i);
+    journal.push_back(Change{k, i, p, true});
+}
+
+/* Unassigns the i-th section of demand k from its p-th candidate node. */
+void HeuristicSolver::unassign(const int k, const int i, const int p)
+{
+    const int f = hot.getSectionVnf(k, i);
+    const int v = hot.getCandidate(k, i, p);
+    const std::size_t n = (std::size_t)v * hot.getNbVnfs() + f;
+    solution.assignment(k, i, p) = 0.0;
+    if (--users[n] == 0){
+        solution.installed[n] = 0.0;
+        solution.cost -= hot.getPlacementCost(f, v);
+    }
+    nbSectionNodes[hot.getSection(k, i)]--;
+    residualCapacity[v] += hot.getSectionLoad(k, i);
+    journal.push_back(Change{k, i, p, false});
+}
+
+/* Undoes the changes in the journal, last first. Undoing appends to the journal, which is emptied at the end. */
+void HeuristicSolver::rollback()
+{
+    for (int c = (int)journal.size() - 1; c >= 0; c--){
+        const Change change = journal[c];
+        if (change.assigned){
+            unassign(change.k, change.i, change.p);
+        }
+        else{
+            assign(change.k, change.i, change.p);
+        }
+    }
+    journal.clear();
+}
+
+/* Returns the cost of installing vnf f on node v: zero if it already is. */
+double HeuristicSolver::getNewCost(const int f, const int v) const
+{
+    return (users[(std::size_t)v * hot.getNbVnfs() + f] > 0) ? 0.0 : hot.getPlacementCost(f, v);
+}
+
+/* Returns true if the p-th candidate node of the i-th section of demand k is not assigned to it and fits it in its capacity. */
+bool HeuristicSolver::canAssign(const int k, const int i, const int p) const
+{
+    return (solution.assignment(k, i, p) == 0.0 && residualCapacity[hot.getCandidate(k, i, p)] >= hot.getSectionLoad(k, i));
+}
+
+/* Checks the chain availability of demand k with the kernels of the lazy constraints, in section order. */
+bool HeuristicSolver::isAvailable(const int k)
+{
+    sectionLogAvailability.resize(hot.getNbSections(k));
+    for (int i = 0; i < hot.getNbSections(k); i++){
+        double logFailure = sumLogFailureMasked(hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i), solution.assignment.section(k, i), hot.getNbCandidates(k, i), 0.5);
+        sectionLogAvailability[i] = getLogAvailabilityFromLogFailure(logFailure);
+    }
+    return (sumLogValues(sectionLogAvailability.data(), hot.getNbSections(k)) >= hot.getLogRequiredAvailability(k));
+}
+
+/* Builds the greedy placement, demand by demand. */
+bool HeuristicSolver::greedy()
+{
+    std::fill(solution.assignment.data(), solution.assignment.data() + solution.assignment.size(), 0.0);
+    solution.installed.assign((std::size_t)hot.getNbNodes() * hot.getNbVnfs(), 0.0);
+    solution.cost = 0.0;
+    users.assign((std::size_t)hot.getNbNodes() * hot.getNbVnfs(), 0);
+    nbSectionNodes.assign(hot.getNbSections(), 0);
+    residualCapacity = hot.getCapacities();
+
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        /* Assign each section to the nodes of lowest cost per unit of reliability. */
+        for (int i = 0; i < hot.getNbSections(k); i++){
+            const int f = hot.getSectionVnf(k, i);
+            while (nbSectionNodes[hot.getSection(k, i)] < HEURISTIC_MIN_NODES){
+                int bestPosition = -1;
+                double bestRatio = IloInfinity;
+                for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                    const int v = hot.getCandidate(k, i, p);
+                    /* A node that always fails adds no reliability, and its ratio is not a number. */
+                    if (!canAssign(k, i, p) || hot.getLogFailure(v) >= 0.0){
+                        continue;
+                    }
+                    double ratio = getNewCost(f, v) / -hot.getLogFailure(v);
+                    if (bestPosition == -1 || ratio < bestRatio || (ratio == bestRatio && hot.getAvailability(v) > hot.getAvailability(hot.getCandidate(k, i, bestPosition)))){
+                        bestRatio = ratio;
+                        bestPosition = p;
+                    }
+                }
+                if (bestPosition == -1){
+                    return false;
+                }
+                assign(k, i, bestPosition);
+            }
+        }
+
+        /* Add the placements of lowest cost per unit of log availability until the chain is available. */
+        while (!isAvailable(k)){
+            int bestSection = -1;
+            int bestPosition = -1;
+            double bestRatio = IloInfinity;
+            double bestGain = 0.0;
+            for (int i = 0; i < hot.getNbSections(k); i++){
+                const int f = hot.getSectionVnf(k, i);
+                const double logFailure = sumLogFailureMasked(hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i), solution.assignment.section(k, i), hot.getNbCandidates(k, i), 0.5);
+                const double logAvailability = getLogAvailabilityFromLogFailure(logFailure);
+                for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                    const int v = hot.getCandidate(k, i, p);
+                    if (!canAssign(k, i, p)){
+                        continue;
+                    }
+                    double gain = getLogAvailabilityFromLogFailure(logFailure + hot.getLogFailure(v)) - logAvailability;
+                    if (gain <= 0.0){
+                        continue;
+                    }
+                    double ratio = getNewCost(f, v) / gain;
+                    if (ratio < bestRatio || (ratio == bestRatio && gain > bestGain)){
+                        bestRatio = ratio;
+                        bestGain = gain;
+                        bestSection = i;
+                        bestPosition = p;
+                    }
+                }
+            }
+            if (bestSection == -1){
+                return false;
+            }
+            assign(k, bestSection, bestPosition);
+        }
+    }
+    journal.clear();
+    return true;
+}
+
+/* Drops or moves every section using vnf f on node v, so that it can be uninstalled. */
+bool HeuristicSolver::tryDrop(const int v, const int f)
+{
+    if (hot.getPlacementCost(f, v) <= HEURISTIC_EPS){
+        return false;
+    }
+    journal.clear();
+    for (int n = 0; n < hot.getNbSectionsOfVnf(f); n++){
+        const int s = hot.getSectionOfVnf(f, n);
+        const int k = hot.getSectionDemand(s);
+        const int i = hot.getSectionPosition(s);
+        const int p = hot.getCandidatePosition(k, i, v);
+        if (p == -1 || solution.assignment(k, i, p) == 0.0){
+            continue;
+        }
+        unassign(k, i, p);
+        if (nbSectionNodes[s] >= HEURISTIC_MIN_NODES && isAvailable(k)){
+            continue;
+        }
+        /* Move: try the most available candidate where f is installed. If it does not restore the availability, no other will. */
+        bool moved = false;
+        for (int q = hot.getNbCandidates(k, i) - 1; q >= 0; q--){
+            const int r = hot.getCandidateByAvailability(k, i, q);
+            const int w = hot.getCandidate(k, i, r);
+            if (w == v || users[(std::size_t)w * hot.getNbVnfs() + f] == 0 || !canAssign(k, i, r)){
+                continue;
+            }
+            assign(k, i, r);
+            moved = (nbSectionNodes[s] >= HEURISTIC_MIN_NODES && isAvailable(k));
+            break;
+        }
+        if (!moved){
+            rollback();
+            return false;
+        }
+    }
+    journal.clear();
+    return true;
+}
+
+/* Installs vnf f on a cheaper node than v, cheapest first, and moves all its sections there. */
+bool HeuristicSolver::trySwap(const int v, const int f)
+{
+    for (int p = 0; p < hot.getNbNodes(); p++){
+        const int w = nodesByCost[(std::size_t)f * hot.getNbNodes() + p];
+        if (hot.getPlacementCost(f, w) >= hot.getPlacementCost(f, v) - HEURISTIC_EPS){
+            break;
+        }
+        if (users[(std::size_t)w * hot.getNbVnfs() + f] > 0){
+            continue;
+        }
+        journal.clear();
+        bool swapped = true;
+        for (int n = 0; n < hot.getNbSectionsOfVnf(f) && swapped; n++){
+            const int s = hot.getSectionOfVnf(f, n);
+            const int k = hot.getSectionDemand(s);
+            const int i = hot.getSectionPosition(s);
+            const int p = hot.getCandidatePosition(k, i, v);
+            if (p == -1 || solution.assignment(k, i, p) == 0.0){
+                continue;
+            }
+            unassign(k, i, p);
+            const int r = hot.getCandidatePosition(k, i, w);
+            swapped = (r != -1 && canAssign(k, i, r));
+            if (swapped){
+                assign(k, i, r);
+                swapped = isAvailable(k);
+            }
+        }
+        if (swapped){
+            journal.clear();
+            return true;
+        }
+        rollback();
+    }
+    return false;
+}
+
+/* Applies improving moves, most expensive installations first, until there is none. */
+void HeuristicSolver::localSearch()
+{
+    std::vector<int> order;
+    bool improved = true;
+    for (int pass = 0; pass < HEURISTIC_MAX_PASSES && improved; pass++){
+        improved = false;
+        order.clear();
+        for (int v = 0; v < hot.getNbNodes(); v++){
+            for (int f = 0; f < hot.getNbVnfs(); f++){
+                if (users[(std::size_t)v * hot.getNbVnfs() + f] > 0){
+                    order.push_back(v * hot.getNbVnfs() + f);
+                }
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [this](const int a, const int b){ 
+            return hot.getPlacementCost(a % hot.getNbVnfs(), a / hot.getNbVnfs()) > hot.getPlacementCost(b % hot.getNbVnfs(), b / hot.getNbVnfs()); 
+        });
+        for (unsigned int n = 0; n < order.size(); n++){
+            const int v = order[n] / hot.getNbVnfs();
+            const int f = order[n] % hot.getNbVnfs();
+            if (users[(std::size_t)v * hot.getNbVnfs() + f] == 0){
+                continue;
+            }
+            if (tryDrop(v, f) || trySwap(v, f)){
+                nbMoves++;
+                improved = true;
+            }
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										Display											*/
+/****************************************************************************************/
+
+/* Displays the placement found and the statistics of the run. */
+void HeuristicSolver::printResult() const
+{
+    if (feasible){
+        std::cout << "=> VNF placement solution ..." << std::endl;
+        for (int v = 0; v < hot.getNbNodes(); v++){
+            std::string vnfs;
+            for (int f = 0; f < hot.getNbVnfs(); f++){
+                if (solution.installed[(std::size_t)v * hot.getNbVnfs() + f] > 0.5){
+                    vnfs += data.getVnf(f).getName();
+                    vnfs += ", ";
+                }
+            }
+            if (!vnfs.empty()){
+                vnfs.pop_back();
+                vnfs.pop_back();
+                vnfs += ".";
+                std::cout << "\t" << data.getNode(v).getName() << ": " << vnfs << std::endl;
+            }
+        }
+        std::cout << "Objective value: " << solution.cost << std::endl;
+        std::cout << "Greedy objective value: " << greedyCost << std::endl;
+        std::cout << "Local search moves: " << nbMoves << std::endl;
+    }
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
@@ -0,0 +1,134 @@
+#ifndef __heuristic__hpp
+#define __heuristic__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+#include "../tools/matrix.hpp"
+#include "../tools/availability.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define HEURISTIC_MIN_NODES     2       // Number of nodes every section must be assigned to
+#define HEURISTIC_MAX_PASSES    100     // Maximum number of passes of the local search over the installed vnfs
+#define HEURISTIC_EPS           1e-9    // Smallest cost decrease accepted by the local search
+
+
+/****************************************************************************************/
+/*									Auxiliary Structs     								*/
+/****************************************************************************************/
+/** A complete solution: the value of every x and y variable, and its cost. **/
+struct Placement {
+    RaggedMatrix<IloNum>    assignment;     /**< assignment(k, i, p) is 1 if the i-th section of demand k is assigned to its p-th candidate node, 0 otherwise. Stored in the order of the columns. **/
+    std::vector<IloNum>     installed;      /**< 1 if vnf f is installed on node v, stored at v * nbVnfs + f. **/
+    double                  cost;           /**< Placement cost. **/
+};
+
+
+/****************************************************************************************
+ * This class finds a placement without CPLEX, in two phases:
+ *  - greedy: demand by demand, each section is assigned to the nodes with the lowest
+ *    ratio between the cost of installing its vnf there (zero if it already is) and the
+ *    reliability -log(1 - a_v) of the node, nodes of zero reliability aside, until it has HEURISTIC_MIN_NODES of them and
+ *    the chain meets its required availability;
+ *  - local search, by first improvement over the installed vnfs, most expensive first:
+ *      drop: unassign every section using the installation, when it stays feasible;
+ *      move: otherwise reassign the section to another node where the vnf is installed;
+ *      swap: install the vnf on a cheaper node instead, and move all its sections there.
+ * Every move respects the node capacities and is accepted only if each demand it touches
+ * keeps its required availability, checked with the kernels of the lazy constraints.
+****************************************************************************************/
+class HeuristicSolver {
+
+private:
+    const Data&             data;           /**< The instance. **/
+    const HotData&          hot;            /**< Contiguous view of the instance. **/
+
+    /** A change of the assignment, kept to be undone. **/
+    struct Change { 
+        int k; 
+        int i; 
+        int p;                              /**< Position of the node among the candidates of the section. **/
+        bool assigned;                      /**< True if (k, i) was assigned to its p-th candidate, false if it was unassigned. **/
+    };
+
+    /*** Current solution ***/
+    Placement               solution;       /**< The current placement. **/
+    std::vector<int>        users;          /**< Number of sections assigned to node v with vnf f, stored at v * nbVnfs + f. **/
+    std::vector<int>        nbSectionNodes; /**< Number of nodes each section is assigned to, by flat section id. **/
+    std::vector<double>     residualCapacity;/**< Capacity left on each node. **/
+    std::vector<Change>     journal;        /**< Changes of the move being tried. **/
+    std::vector<double>     sectionLogAvailability; /**< Buffer for the availability checks. **/
+    std::vector<int>        nodesByCost;    /**< The nodes of each vnf f by increasing placement cost, stored from f * nbNodes. **/
+
+    /*** Statistics ***/
+    double                  greedyCost;     /**< Cost after the greedy phase. **/
+    int                     nbMoves;        /**< Number of improving moves applied by the local search. **/
+    double                  time;           /**< Time spent, in seconds. **/
+    bool                    feasible;       /**< True if a placement was found. **/
+
+    /** Assigns the i-th section of demand k to its p-th candidate node, installing its vnf if needed. **/
+    void    assign(const int k, const int i, const int p);
+    /** Unassigns the i-th section of demand k from its p-th candidate node, uninstalling its vnf if no section uses it any more. **/
+    void    unassign(const int k, const int i, const int p);
+    /** Undoes the changes in the journal. **/
+    void    rollback();
+    /** Returns the cost of installing vnf f on node v in the current solution: zero if it already is. **/
+    double  getNewCost(const int f, const int v) const;
+    /** Returns true if the i-th section of demand k can be assigned to its p-th candidate node. **/
+    bool    canAssign(const int k, const int i, const int p) const;
+
+    /** Builds the greedy placement. Returns false if some demand cannot be satisfied. **/
+    bool    greedy();
+    /** Tries to remove the installation of vnf f on node v by dropping or moving its sections. Keeps the result and returns true if it lowers the cost. **/
+    bool    tryDrop(const int v, const int f);
+    /** Tries to install vnf f on a cheaper node than v, cheapest first, and to move all its sections there. Keeps the result and returns true if it lowers the cost. **/
+    bool    trySwap(const int v, const int f);
+    /** Applies improving moves until there is none. **/
+    void    localSearch();
+
+public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+    /** Constructor. @param data The instance. **/
+    HeuristicSolver(const Data& data);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Runs the greedy and the local search. Returns true if a feasible placement was found. **/
+    bool    run();
+
+    /** Returns true if the chain availability of demand k in the current placement meets its requirement. **/
+    bool    isAvailable(const int k);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the placement found. **/
+    const Placement& getSolution()  const { return solution; }
+    /** Returns true if a feasible placement was found. **/
+    bool    isFeasible()            const { return feasible; }
+
+	/****************************************************************************************/
+	/*										Display											*/
+	/****************************************************************************************/
+    /** Displays the placement found and the statistics of the run. **/
+    void    printResult() const;
+};
+
+#endif
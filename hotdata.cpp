@@ -0,0 +1,150 @@
+#include "hotdata.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+HotData::HotData(const std::vector<Node>& tabNodes, const std::vector<VNF>& tabVnfs, const std::vector<Demand>& tabDemands, const double maxPlacementCost, const DelayTable& delays) :
+                nbNodes((int)tabNodes.size()), nbVnfs((int)tabVnfs.size()), nbDemands((int)tabDemands.size())
+{
+    /* Nodes */
+    availability.resize(nbNodes);
+    log_failure.resize(nbNodes);
+    capacity.resize(nbNodes);
+    for (int v = 0; v < nbNodes; v++){
+        availability[v] = tabNodes[v].getAvailability();
+        log_failure[v] = std::log1p(-availability[v]);
+        capacity[v] = tabNodes[v].getCapacity();
+    }
+
+    /* VNFs */
+    consumption.resize(nbVnfs);
+    placement_cost.resize((std::size_t)nbVnfs * nbNodes);
+    for (int f = 0; f < nbVnfs; f++){
+        consumption[f] = tabVnfs[f].getConsumption();
+        for (int v = 0; v < nbNodes; v++){
+            placement_cost[(std::size_t)f * nbNodes + v] = tabVnfs[f].getPlacementCostOnNode(v);
+        }
+    }
+
+    /* Demands */
+    bandwidth.resize(nbDemands);
+    required_availability.resize(nbDemands);
+    log_required_availability.resize(nbDemands);
+    source.resize(nbDemands);
+    target.resize(nbDemands);
+    max_latency.resize(nbDemands);
+    chain_offsets.resize(nbDemands + 1, 0);
+    for (int k = 0; k < nbDemands; k++){
+        bandwidth[k] = tabDemands[k].getBandwidth();
+        required_availability[k] = tabDemands[k].getAvailability();
+        log_required_availability[k] = std::log(required_availability[k]);
+        source[k] = tabDemands[k].getSource();
+        target[k] = tabDemands[k].getTarget();
+        max_latency[k] = tabDemands[k].getMaxLatency();
+        chain_offsets[k+1] = chain_offsets[k] + tabDemands[k].getNbVNFs();
+    }
+    chain_vnfs.reserve(chain_offsets[nbDemands]);
+    section_load.reserve(chain_offsets[nbDemands]);
+    section_demand.reserve(chain_offsets[nbDemands]);
+    for (int k = 0; k < nbDemands; k++){
+        for (int i = 0; i < tabDemands[k].getNbVNFs(); i++){
+            int f = tabDemands[k].getVNF_i(i);
+            chain_vnfs.push_back(f);
+            section_load.push_back(bandwidth[k] * consumption[f]);
+            section_demand.push_back(k);
+        }
+    }
+
+    /* Inverted index, by counting sort on the vnf of each section. */
+    vnf_section_offsets.assign(nbVnfs + 1, 0);
+    for (unsigned int s = 0; s < chain_vnfs.size(); s++){
+        vnf_section_offsets[chain_vnfs[s] + 1]++;
+    }
+    for (int f = 0; f < nbVnfs; f++){
+        vnf_section_offsets[f+1] += vnf_section_offsets[f];
+    }
+    vnf_sections.resize(chain_vnfs.size());
+    std::vector<int> next(vnf_section_offsets.begin(), vnf_section_offsets.end() - 1);
+    for (unsigned int s = 0; s < chain_vnfs.size(); s++){
+        vnf_sections[next[chain_vnfs[s]]++] = (int)s;
+    }
+
+    /* Presolve: the candidate nodes of each section, by increasing node id. */
+    const int nbSections = (int)chain_vnfs.size();
+    candidate_offsets.assign(nbSections + 1, 0);
+    max_candidates = 0;
+    for (int s = 0; s < nbSections; s++){
+        for (int v = 0; v < nbNodes; v++){
+            if (isCandidateNode(s, v, maxPlacementCost, delays)){
+                candidate_nodes.push_back(v);
+                candidate_sections.push_back(s);
+                candidate_log_failure.push_back(log_failure[v]);
+            }
+        }
+        candidate_offsets[s+1] = (int)candidate_nodes.size();
+        max_candidates = std::max(max_candidates, candidate_offsets[s+1] - candidate_offsets[s]);
+    }
+
+    /* The candidates of each section by increasing availability. The sort is stable, so ties keep the node order. */
+    const int nbColumns = (int)candidate_nodes.size();
+    candidates_by_availability.resize(nbColumns);
+    candidate_sorted_availability.resize(nbColumns);
+    for (int s = 0; s < nbSections; s++){
+        const int first = candidate_offsets[s];
+        std::vector<int>::iterator positions = candidates_by_availability.begin() + first;
+        for (int p = 0; p < candidate_offsets[s+1] - first; p++){
+            positions[p] = p;
+        }
+        std::stable_sort(positions, candidates_by_availability.begin() + candidate_offsets[s+1], 
+                            [this, first](const int p, const int q){ return availability[candidate_nodes[first + p]] < availability[candidate_nodes[first + q]]; });
+        for (int c = first; c < candidate_offsets[s+1]; c++){
+            candidate_sorted_availability[c] = availability[candidate_nodes[first + candidates_by_availability[c]]];
+        }
+    }
+
+    /* The columns of each node, by counting sort on the node of each column. */
+    node_column_offsets.assign(nbNodes + 1, 0);
+    for (int c = 0; c < nbColumns; c++){
+        node_column_offsets[candidate_nodes[c] + 1]++;
+    }
+    for (int v = 0; v < nbNodes; v++){
+        node_column_offsets[v+1] += node_column_offsets[v];
+    }
+    node_columns.resize(nbColumns);
+    std::vector<int> nextColumn(node_column_offsets.begin(), node_column_offsets.end() - 1);
+    for (int c = 0; c < nbColumns; c++){
+        node_columns[nextColumn[candidate_nodes[c]]++] = c;
+    }
+}
+
+/****************************************************************************************/
+/*										Presolve										*/
+/****************************************************************************************/
+
+/* The candidates of a section are sorted by node id: a binary search finds the position of a node. */
+int HotData::getCandidatePosition(const int k, const int i, const int v) const
+{
+    const int s = chain_offsets[k] + i;
+    std::vector<int>::const_iterator first = candidate_nodes.begin() + candidate_offsets[s];
+    std::vector<int>::const_iterator last = candidate_nodes.begin() + candidate_offsets[s+1];
+    std::vector<int>::const_iterator it = std::lower_bound(first, last, v);
+    return (it != last && *it == v) ? (int)(it - first) : -1;
+}
+
+/* A node whose capacity is below the section load can never host it, nor can a node too far from the path: the demand goes from its source to the node and on to its target, so the shortest delays through the node must fit in its budget. Demands without a positive budget are not checked. A node where the vnf costs more than the limit is excluded by choice. */
+bool HotData::isCandidateNode(const int s, const int v, const double maxPlacementCost, const DelayTable& delays) const
+{
+    if (section_load[s] > capacity[v]){
+        return false;
+    }
+    const int k = section_demand[s];
+    if (!delays.isEmpty() && max_latency[k] > 0.0 && delays.getDelay(source[k], v) + delays.getDelay(v, target[k]) > max_latency[k]){
+        return false;
+    }
+    if (maxPlacementCost >= 0.0 && getPlacementCost(chain_vnfs[s], v) > maxPlacementCost){
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+#ifndef __hotdata__hpp
+#define __hotdata__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+/*** Own Libraries ***/
+#include "../network/demand.hpp"
+#include "../network/node.hpp"
+#include "../network/vnf.hpp"
+#include "../network/delaytable.hpp"
+
+
+/********************************************************************************************
+ * This class is a read-only structure-of-arrays view over the nodes, vnfs and demands, 
+ * holding only the numbers needed while building the model and separating cuts. Node data
+ * is indexed by node id, the placement costs are stored as a flat nbVnfs x nbNodes matrix,
+ * and the demand chains are flattened: the sections of demand k are the positions 
+ * chain_offsets[k] ... chain_offsets[k+1]-1 of the section arrays. A presolve keeps, for each
+ * section, the nodes that may host it: only these candidates get an assignment variable,
+ * and the variable of the p-th candidate of section s is the column candidate_offsets[s] + p.
+ * Everything about candidates is stored per column, so no structure grows with the number
+ * of sections times the number of nodes.
+********************************************************************************************/
+class HotData {
+
+private:
+	int 				nbNodes;					/**< Number of nodes. **/
+	int 				nbVnfs;						/**< Number of vnfs. **/
+	int 				nbDemands;					/**< Number of demands. **/
+
+	/*** Nodes ***/
+	std::vector<double> availability;				/**< Availability of each node. **/
+	std::vector<double> log_failure;				/**< Logarithm of the failure probability, log(1 - a_v), of each node. **/
+	std::vector<double> capacity;					/**< Capacity of each node. **/
+
+	/*** VNFs ***/
+	std::vector<double> consumption;				/**< Resource consumption of each vnf. **/
+	std::vector<double> placement_cost;				/**< Placement cost of vnf f on node v, stored at f * nbNodes + v. **/
+
+	/*** Demands ***/
+	std::vector<double> bandwidth;					/**< Requested bandwidth of each demand. **/
+	std::vector<double> required_availability;		/**< Requested availability of each demand. **/
+	std::vector<double> log_required_availability;	/**< Logarithm of the requested availability of each demand. **/
+	std::vector<int> 	source;						/**< Source node of each demand. **/
+	std::vector<int> 	target;						/**< Target node of each demand. **/
+	std::vector<double> max_latency;				/**< Latency budget of each demand. **/
+	std::vector<int> 	chain_offsets;				/**< First section of each demand, plus one past the last section. **/
+	std::vector<int> 	chain_vnfs;					/**< VNF id of each section. **/
+	std::vector<double> section_load;				/**< Resources consumed by each section on a node it is assigned to: bandwidth x consumption. **/
+	std::vector<int> 	section_demand;				/**< Demand of each section. **/
+
+	/*** Inverted index: the sections of each vnf ***/
+	std::vector<int> 	vnf_section_offsets;		/**< First position in vnf_sections of each vnf, plus one past the last position. **/
+	std::vector<int> 	vnf_sections;				/**< Flat ids of the sections of each vnf, by increasing id. **/
+
+	/*** Presolve: the candidate nodes of each section ***/
+	std::vector<int> 	candidate_offsets;			/**< First column of each section, plus one past the last column. **/
+	std::vector<int> 	candidate_nodes;			/**< Node of each column, by increasing node id within a section. **/
+	std::vector<int> 	candidate_sections;			/**< Flat section id of each column. **/
+	std::vector<double> candidate_log_failure;		/**< Logarithm of the failure probability of the node of each column. **/
+	std::vector<int> 	candidates_by_availability;	/**< Positions of the candidates of each section by increasing availability, stored from the first column of the section. **/
+	std::vector<double> candidate_sorted_availability;	/**< Availability of the candidate at the same place of candidates_by_availability. **/
+	std::vector<int> 	node_column_offsets;		/**< First position in node_columns of each node, plus one past the last position. **/
+	std::vector<int> 	node_columns;				/**< Columns of each node, by increasing column. **/
+	int 				max_candidates;				/**< Largest number of candidates of a section. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+
+	/** Constructor. Builds an empty view. **/
+	HotData() : nbNodes(0), nbVnfs(0), nbDemands(0), max_candidates(0) {}
+
+	/** Constructor. Copies the hot fields of the given objects into contiguous arrays and computes the candidate nodes of each section. @param tabNodes The nodes. @param tabVnfs The vnfs. @param tabDemands The demands. @param maxPlacementCost Nodes where installing the vnf of a section costs more are not candidates for it; negative for no limit. @param delays The shortest delays between nodes, or an empty table if latencies are not used. **/
+	HotData(const std::vector<Node>& tabNodes, const std::vector<VNF>& tabVnfs, const std::vector<Demand>& tabDemands, const double maxPlacementCost, const DelayTable& delays);
+
+	/****************************************************************************************/
+	/*										Presolve										*/
+	/****************************************************************************************/
+
+	/** Returns true if node v may host the vnf of section s: the section fits in its capacity, the placement cost is within the limit and going through v fits in the latency budget of the demand. **/
+	bool 	isCandidateNode 	(const int s, const int v, const double maxPlacementCost, const DelayTable& delays) const;
+
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+
+	int 	getNbNodes    () 							const { return nbNodes; }
+	int 	getNbVnfs     () 							const { return nbVnfs; }
+	int 	getNbDemands  () 							const { return nbDemands; }
+	/** Returns the total number of sections over all demands. **/
+	int 	getNbSections () 							const { return (int)chain_vnfs.size(); }
+
+	double 	getAvailability 	(const int v) 			const { return availability[v]; }
+	double 	getLogFailure 		(const int v) 			const { return log_failure[v]; }
+	double 	getCapacity 		(const int v) 			const { return capacity[v]; }
+	double 	getConsumption 		(const int f) 			const { return consumption[f]; }
+	double 	getPlacementCost 	(const int f, const int v) const { return placement_cost[(std::size_t)f * nbNodes + v]; }
+
+	double 	getBandwidth 		(const int k) 			const { return bandwidth[k]; }
+	double 	getRequiredAvailability (const int k) 		const { return required_availability[k]; }
+	double 	getLogRequiredAvailability (const int k) 	const { return log_required_availability[k]; }
+	int 	getSource 			(const int k) 			const { return source[k]; }
+	int 	getTarget 			(const int k) 			const { return target[k]; }
+	double 	getMaxLatency 		(const int k) 			const { return max_latency[k]; }
+	/** Returns the number of sections (VNFs) of demand k. **/
+	int 	getNbSections 		(const int k) 			const { return chain_offsets[k+1] - chain_offsets[k]; }
+	/** Returns the flat index of the i-th section of demand k. **/
+	int 	getSection 			(const int k, const int i) const { return chain_offsets[k] + i; }
+	/** Returns the VNF id of the i-th section of demand k. **/
+	int 	getSectionVnf 		(const int k, const int i) const { return chain_vnfs[chain_offsets[k] + i]; }
+	/** Returns the resources consumed by the i-th section of demand k on a node it is assigned to. **/
+	double 	getSectionLoad 		(const int k, const int i) const { return section_load[chain_offsets[k] + i]; }
+	/** Returns the demand of the section with flat id s. **/
+	int 	getSectionDemand 	(const int s) 			const { return section_demand[s]; }
+	/** Returns the position in its chain of the section with flat id s. **/
+	int 	getSectionPosition 	(const int s) 			const { return s - chain_offsets[section_demand[s]]; }
+	/** Returns the number of sections, over all demands, whose vnf is f. **/
+	int 	getNbSectionsOfVnf 	(const int f) 			const { return vnf_section_offsets[f+1] - vnf_section_offsets[f]; }
+	/** Returns the flat id of the n-th section whose vnf is f. **/
+	int 	getSectionOfVnf 	(const int f, const int n) const { return vnf_sections[vnf_section_offsets[f] + n]; }
+
+	/** Returns the total number of columns, that is, of assignment variables. **/
+	int 	getNbColumns 		() 						const { return (int)candidate_nodes.size(); }
+	/** Returns the number of candidate nodes of the i-th section of demand k. **/
+	int 	getNbCandidates 	(const int k, const int i) const { int s = chain_offsets[k] + i; return candidate_offsets[s+1] - candidate_offsets[s]; }
+	/** Returns the largest number of candidate nodes of a section. **/
+	int 	getMaxCandidates 	() 						const { return max_candidates; }
+	/** Returns the column of the first candidate of the i-th section of demand k. **/
+	int 	getFirstColumn 		(const int k, const int i) const { return candidate_offsets[chain_offsets[k] + i]; }
+	/** Returns the p-th candidate node of the i-th section of demand k. **/
+	int 	getCandidate 		(const int k, const int i, const int p) const { return candidate_nodes[candidate_offsets[chain_offsets[k] + i] + p]; }
+	/** Returns the position among the candidates of the i-th section of demand k of its q-th candidate by increasing availability. **/
+	int 	getCandidateByAvailability (const int k, const int i, const int q) const { return candidates_by_availability[candidate_offsets[chain_offsets[k] + i] + q]; }
+	/** Returns the position of node v among the candidates of the i-th section of demand k, or -1 if v is not a candidate. Takes a binary search. **/
+	int 	getCandidatePosition(const int k, const int i, const int v) const;
+	/** Returns the column of node v on the i-th section of demand k, or -1 if v is not a candidate. Takes a binary search. **/
+	int 	getColumn 			(const int k, const int i, const int v) const { int p = getCandidatePosition(k, i, v); return (p == -1) ? -1 : getFirstColumn(k, i) + p; }
+	/** Returns true if node v is a candidate for the i-th section of demand k. Takes a binary search. **/
+	bool 	isCandidate 		(const int k, const int i, const int v) const { return getCandidatePosition(k, i, v) != -1; }
+	/** Returns the flat id of the section of column c. **/
+	int 	getColumnSection 	(const int c) 			const { return candidate_sections[c]; }
+	/** Returns the number of columns of node v, over all sections. **/
+	int 	getNbColumnsOfNode 	(const int v) 			const { return node_column_offsets[v+1] - node_column_offsets[v]; }
+	/** Returns the n-th column of node v. **/
+	int 	getColumnOfNode 	(const int v, const int n) const { return node_columns[node_column_offsets[v] + n]; }
+
+	const std::vector<double>& 	getAvailabilities () 	const { return availability; }
+	const std::vector<double>& 	getLogFailures 	  () 	const { return log_failure; }
+	const std::vector<double>& 	getCapacities 	  () 	const { return capacity; }
+	const std::vector<double>& 	getPlacementCosts () 	const { return placement_cost; }
+	const std::vector<int>& 	getChainOffsets   () 	const { return chain_offsets; }
+	const std::vector<int>& 	getChainVnfs 	  () 	const { return chain_vnfs; }
+	const std::vector<double>& 	getSectionLoads   () 	const { return section_load; }
+	const std::vector<int>& 	getCandidateOffsets () 	const { return candidate_offsets; }
+	/** Returns the logarithm of the failure probability of the node of each column. **/
+	const std::vector<double>& 	getCandidateLogFailures () const { return candidate_log_failure; }
+	/** Returns, from the first column of each section, the availabilities of its candidates by increasing availability. **/
+	const std::vector<double>& 	getCandidateSortedAvailabilities () const { return candidate_sorted_availability; }
+};
+
+#endif
@@ -11,11 +11,47 @@ Input::Input(const std::string filename) : parameters_file(filename){
     link_file = getParameterValue("linkFile=");
     demand_file = getParameterValue("demandFile=");
     vnf_file = getParameterValue("vnfFile=");
+    snapshot_file = getParameterValue("snapshotFile=");
+    delay_file = getParameterValue("delayFile=");
 
+    run_mode = (Run_Mode)getIntParameterValue("runMode=", RUN_MIP);
+    if (run_mode < RUN_MIP || run_mode > RUN_MIP_HEURISTIC_START){
+        std::cerr << "ERROR: Unknown run mode '" << run_mode << "'." << std::endl; 
+        exit(EXIT_FAILURE);
+    }
     linear_relaxation = std::stoi(getParameterValue("linearRelaxation="));
     time_limit = std::stoi(getParameterValue("timeLimit="));
+    separation_mode = (Separation_Mode)getIntParameterValue("separationMode=", SEPARATION_HEURISTIC);
+    if (separation_mode < SEPARATION_HEURISTIC || separation_mode > SEPARATION_HYBRID){
+        std::cerr << "ERROR: Unknown separation mode '" << separation_mode << "'." << std::endl; 
+        exit(EXIT_FAILURE);
+    }
+    lifting_mode = (Lifting_Mode)getIntParameterValue("liftingMode=", LIFTING_SEQUENTIAL);
+    if (lifting_mode < LIFTING_SEQUENTIAL || lifting_mode > LIFTING_AVAILABILITY_ORDER){
+        std::cerr << "ERROR: Unknown lifting mode '" << lifting_mode << "'." << std::endl; 
+        exit(EXIT_FAILURE);
+    }
+    separation_frequency = std::max(1, getIntParameterValue("separationFrequency=", 1));
+    separation_max_depth = getIntParameterValue("separationMaxDepth=", -1);
+    separation_min_efficacy = getDoubleParameterValue("separationMinEfficacy=", 0.0);
+    separation_time_share = getDoubleParameterValue("separationTimeShare=", 1.0);
+    separation_threads = std::max(1, getIntParameterValue("separationThreads=", 1));
+    build_threads = getIntParameterValue("buildThreads=", 0);
+    if (build_threads <= 0){
+        build_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    heuristic_max_depth = getIntParameterValue("heuristicMaxDepth=", -1);
+    mip_start_effort = getIntParameterValue("mipStartEffort=", 1);
+    if (mip_start_effort < 0 || mip_start_effort > 5){
+        std::cerr << "ERROR: Unknown MIP start effort '" << mip_start_effort << "'." << std::endl; 
+        exit(EXIT_FAILURE);
+    }
+    max_placement_cost = getDoubleParameterValue("maxPlacementCost=", -1.0);
+    latency_pruning = (getIntParameterValue("latencyPruning=", 0) != 0);
 
     output_file = getParameterValue("outputFile=");
+    mip_start_file = getParameterValue("mipStartFile=");
+    lp_file = getParameterValue("lpFile=");
 
     print();
 }
@@ -48,11 +84,43 @@ std::string Input::getParameterValue(std::string pattern){
     return value;
 }
 
+/* Returns the pattern value in the parameters file as an integer, or the default value if the field is missing or empty. */
+int Input::getIntParameterValue(const std::string pattern, const int defaultValue){
+    std::string value = getParameterValue(pattern);
+    if (value.empty()){
+        return defaultValue;
+    }
+    return std::stoi(value);
+}
+
+/* Returns the pattern value in the parameters file as a floating number, or the default value if the field is missing or empty. */
+double Input::getDoubleParameterValue(const std::string pattern, const double defaultValue){
+    std::string value = getParameterValue(pattern);
+    if (value.empty()){
+        return defaultValue;
+    }
+    return std::stod(value);
+}
+
 void Input::print(){
     std::cout << "\t Node File: " << node_file << std::endl;
     std::cout << "\t Link File: " << link_file << std::endl;
     std::cout << "\t Service Chain Function File: " << demand_file << std::endl;
     std::cout << "\t Virtual Network Function File: " << vnf_file << std::endl;
+    std::cout << "\t Snapshot File: " << snapshot_file << std::endl;
+    std::cout << "\t Delay File: " << delay_file << std::endl;
+    std::cout << "\t Run Mode: ";
+    switch (run_mode){
+        case RUN_HEURISTIC:
+            std::cout << "HEURISTIC" << std::endl;
+            break;
+        case RUN_MIP_HEURISTIC_START:
+            std::cout << "MIP WITH HEURISTIC START" << std::endl;
+            break;
+        default:
+            std::cout << "MIP" << std::endl;
+            break;
+    }
     std::cout << "\t Linear Relaxation: ";
     if (linear_relaxation){
         std::cout << "TRUE" << std::endl;
@@ -61,5 +129,54 @@ void Input::print(){
         std::cout << "FALSE" << std::endl;
     }
     std::cout << "\t Time Limit: " << time_limit << " seconds" << std::endl;
+    std::cout << "\t Separation Mode: ";
+    switch (separation_mode){
+        case SEPARATION_KNAPSACK:
+            std::cout << "KNAPSACK" << std::endl;
+            break;
+        case SEPARATION_HYBRID:
+            std::cout << "HYBRID" << std::endl;
+            break;
+        default:
+            std::cout << "HEURISTIC" << std::endl;
+            break;
+    }
+    std::cout << "\t Lifting Mode: " << ((lifting_mode == LIFTING_AVAILABILITY_ORDER) ? "AVAILABILITY-ORDERED" : "SEQUENTIAL") << std::endl;
+    std::cout << "\t Separation Frequency: every " << separation_frequency << " nodes" << std::endl;
+    std::cout << "\t Separation Max Depth: ";
+    if (separation_max_depth < 0){
+        std::cout << "NONE" << std::endl;
+    }
+    else{
+        std::cout << separation_max_depth << std::endl;
+    }
+    std::cout << "\t Separation Min Efficacy: " << separation_min_efficacy << std::endl;
+    std::cout << "\t Separation Time Share: " << separation_time_share << std::endl;
+    std::cout << "\t Separation Threads: " << separation_threads << std::endl;
+    std::cout << "\t Build Threads: " << build_threads << std::endl;
+    std::cout << "\t Heuristic Max Depth: ";
+    if (heuristic_max_depth < 0){
+        std::cout << "NEVER" << std::endl;
+    }
+    else{
+        std::cout << heuristic_max_depth << std::endl;
+    }
+    std::cout << "\t MIP Start Effort: " << mip_start_effort << std::endl;
+    std::cout << "\t Max Placement Cost: ";
+    if (max_placement_cost < 0){
+        std::cout << "NONE" << std::endl;
+    }
+    else{
+        std::cout << max_placement_cost << std::endl;
+    }
+    std::cout << "\t Latency Pruning: ";
+    if (latency_pruning){
+        std::cout << "TRUE" << std::endl;
+    }
+    else{
+        std::cout << "FALSE" << std::endl;
+    }
     std::cout << "\t Output File: " << output_file << std::endl;
+    std::cout << "\t MIP Start File: " << mip_start_file << std::endl;
+    std::cout << "\t LP File: " << lp_file << std::endl;
 }
\ No newline at end of file
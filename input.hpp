@@ -5,7 +5,28 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <thread>
+
+/** Algorithms used for separating availability cuts on fractional solutions. **/
+enum Separation_Mode {
+    SEPARATION_HEURISTIC = 0,   /**< Greedy heuristic only. **/
+    SEPARATION_KNAPSACK = 1,    /**< Knapsack cover separation only. **/
+    SEPARATION_HYBRID = 2       /**< Greedy heuristic, then knapsack separation for the demands where it found no cut. **/
+};
+
+/** What the program does with the instance. **/
+enum Run_Mode {
+    RUN_MIP = 0,                /**< Solves the MIP with CPLEX. **/
+    RUN_HEURISTIC = 1,          /**< Runs the placement heuristic only, without CPLEX. **/
+    RUN_MIP_HEURISTIC_START = 2 /**< Solves the MIP with CPLEX, starting from the placement heuristic solution. **/
+};
 
+/** Orders in which the placements are tried when lifting lazy availability constraints. **/
+enum Lifting_Mode {
+    LIFTING_SEQUENTIAL = 0,     /**< Section by section, nodes by id. **/
+    LIFTING_AVAILABILITY_ORDER = 1  /**< Availability-ordered lifting: nodes by increasing availability, across all sections. **/
+};
 
 /*****************************************************************************************
  * This class stores all the information recovered from the parameter file, that is,
@@ -20,13 +41,30 @@ private:
     std::string         link_file;
     std::string         demand_file;
     std::string         vnf_file;
+    std::string         snapshot_file;
+    std::string         delay_file;
 
     /***** Optimization parameters*****/
+    Run_Mode            run_mode;
     bool                linear_relaxation;
     int                 time_limit;
+    Separation_Mode     separation_mode;
+    Lifting_Mode        lifting_mode;
+    int                 separation_frequency;
+    int                 separation_max_depth;
+    double              separation_min_efficacy;
+    double              separation_time_share;
+    int                 separation_threads;
+    int                 build_threads;
+    int                 heuristic_max_depth;
+    int                 mip_start_effort;
+    double              max_placement_cost;
+    bool                latency_pruning;
 
     /***** Output file paths *****/
     std::string         output_file;
+    std::string         mip_start_file;
+    std::string         lp_file;
     
 public:
 	/********************************************/
@@ -57,12 +95,63 @@ public:
     /* Returns the VNF file. */
     const std::string& getVnfFile()        const { return this->vnf_file; }
 
+    /* Returns the binary snapshot file. */
+    const std::string& getSnapshotFile()   const { return this->snapshot_file; }
+
+    /* Returns the file caching the shortest delays between nodes, or an empty string. */
+    const std::string& getDelayFile()      const { return this->delay_file; }
+
     /* Returns true if linear relaxation is to be applied. */
     const bool&        isRelaxation()      const { return this->linear_relaxation; }
 
+    /* Returns what the program does with the instance. */
+    const Run_Mode&    getRunMode()        const { return this->run_mode; }
+
     /* Returns time limit in seconds to be applied. */
     const int&         getTimeLimit()      const { return this->time_limit; }
 
+    /* Returns the algorithm used for separating availability cuts on fractional solutions. */
+    const Separation_Mode& getSeparationMode() const { return this->separation_mode; }
+
+    /* Returns the order in which placements are tried when lifting lazy constraints. */
+    const Lifting_Mode& getLiftingMode()   const { return this->lifting_mode; }
+
+    /* Returns the number of B&C nodes between two separations below the root. */
+    const int&         getSeparationFrequency()  const { return this->separation_frequency; }
+
+    /* Returns the deepest B&C node where cuts are separated, or -1 for no limit. */
+    const int&         getSeparationMaxDepth()   const { return this->separation_max_depth; }
+
+    /* Returns the mean efficacy under which separation backs off. */
+    const double&      getSeparationMinEfficacy() const { return this->separation_min_efficacy; }
+
+    /* Returns the largest share of the threads time that may be spent in the callback. */
+    const double&      getSeparationTimeShare()  const { return this->separation_time_share; }
+
+    /* Returns the number of threads separating the demands of a single callback invocation. */
+    const int&         getSeparationThreads()    const { return this->separation_threads; }
+
+    /* Returns the number of threads computing the delay table and filling the constraint rows while the model is built. */
+    const int&         getBuildThreads()         const { return this->build_threads; }
+
+    /* Returns the deepest B&C node where the rounding heuristic runs, or -1 if it never runs. */
+    const int&         getHeuristicMaxDepth()    const { return this->heuristic_max_depth; }
+
+    /* Returns the effort CPLEX puts into MIP starts, as a IloCplex::MIPStartEffort value. */
+    const int&         getMipStartEffort()       const { return this->mip_start_effort; }
+
+    /* Returns the placement cost above which a node is not a candidate for a vnf, or a negative value for no limit. */
+    const double&      getMaxPlacementCost()     const { return this->max_placement_cost; }
+
+    /* Returns true if nodes too far from the path of a demand are not candidates for its sections. */
+    const bool&        isLatencyPruning()        const { return this->latency_pruning; }
+
+    /* Returns the file the MIP starts are read from and the best solution is written to, or an empty string. */
+    const std::string& getMipStartFile()   const { return this->mip_start_file; }
+
+    /* Returns the file the model is exported to, or an empty string. Variables and constraints are only named when it is set. */
+    const std::string& getLpFile()         const { return this->lp_file; }
+
     /* Returns the output file. */
     const std::string& getOutputFile()     const { return this->output_file; }
 
@@ -72,6 +161,12 @@ public:
     /* Returns the pattern value in the parameters file. */
     std::string getParameterValue(const std::string pattern);
 
+    /* Returns the pattern value in the parameters file as an integer, or the default value if the field is missing or empty. */
+    int getIntParameterValue(const std::string pattern, const int defaultValue);
+
+    /* Returns the pattern value in the parameters file as a floating number, or the default value if the field is missing or empty. */
+    double getDoubleParameterValue(const std::string pattern, const double defaultValue);
+
 	/********************************************/
 	/*				    Output	    			*/
 	/********************************************/
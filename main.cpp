@@ -13,11 +13,27 @@ int main(int argc, char *argv[]) {
     data.print();
     IloEnv env;
 	
+    if (data.getInput().getRunMode() == RUN_HEURISTIC){
+        HeuristicSolver heuristic(data);
+        heuristic.run();
+        heuristic.printResult();
+        env.end();
+        return 0;
+    }
+
     try
     {
         /* Model construct */
         Model model(env, data);
 
+        /* Start from the placement heuristic */
+        if (data.getInput().getRunMode() == RUN_MIP_HEURISTIC_START){
+            HeuristicSolver heuristic(data);
+            if (heuristic.run()){
+                model.addMipStart(heuristic.getSolution());
+            }
+        }
+
         /* Model run */
         model.run();
 
@@ -0,0 +1,130 @@
+#ifndef __matrix__hpp
+#define __matrix__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <cstddef>
+
+
+/****************************************************************************************
+ * This class implements a dense matrix stored in a single contiguous row-major array.
+ * Reshaping it to a size that fits the current allocation does not allocate memory.
+****************************************************************************************/
+template <typename T>
+class FlatMatrix{
+    private:
+        int             nbRows;     /**< Number of rows. **/
+        int             nbCols;     /**< Number of columns. **/
+        std::vector<T>  values;     /**< Entry (i,j) is stored at i * nbCols + j. **/
+
+    public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+	/** Constructor. Builds an empty matrix. **/
+	FlatMatrix() : nbRows(0), nbCols(0) {}
+
+	/** Constructor. @param rows The number of rows. @param cols The number of columns. @param value The initial value of every entry. **/
+	FlatMatrix(const int rows, const int cols, const T& value = T()) : nbRows(rows), nbCols(cols), values((std::size_t)rows * cols, value) {}
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+	/** Reshapes the matrix and sets every entry to the given value. @param rows The number of rows. @param cols The number of columns. @param value The value of every entry. **/
+	void assign(const int rows, const int cols, const T& value) { nbRows = rows; nbCols = cols; values.assign((std::size_t)rows * cols, value); }
+
+	/** Reserves memory for a matrix of the given size. @param rows The number of rows. @param cols The number of columns. **/
+	void reserve(const int rows, const int cols) { values.reserve((std::size_t)rows * cols); }
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+	int         getNbRows() const { return nbRows; }
+	int         getNbCols() const { return nbCols; }
+
+	T&          operator()(const int i, const int j)       { return values[(std::size_t)i * nbCols + j]; }
+	const T&    operator()(const int i, const int j) const { return values[(std::size_t)i * nbCols + j]; }
+
+	/** Returns the first entry of row i. **/
+	T*          row(const int i)                           { return values.data() + (std::size_t)i * nbCols; }
+	const T*    row(const int i)                     const { return values.data() + (std::size_t)i * nbCols; }
+};
+
+
+/****************************************************************************************
+ * This class implements a ragged three-dimensional array indexed by (demand, section,
+ * node) and stored in a single contiguous array. The sections of all demands are
+ * numbered consecutively: the sections of demand k are chainOffsets[k] ...
+ * chainOffsets[k+1]-1, and the entries of section s are the positions
+ * sectionOffsets[s] ... sectionOffsets[s+1]-1 of the array. Entries of a demand, and
+ * of a section, are therefore contiguous. Sections may have different numbers of entries,
+ * in which case the third index is the position of the entry within its section.
+****************************************************************************************/
+template <typename T>
+class RaggedMatrix{
+    private:
+        std::vector<int>    chainOffsets;       /**< First section of each demand, plus one past the last section. **/
+        std::vector<int>    sectionOffsets;     /**< First entry of each section, plus one past the last entry. **/
+        std::vector<T>      values;             /**< The entries. **/
+
+    public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+	/** Constructor. Builds an empty array. **/
+	RaggedMatrix() {}
+
+	/** Constructor. Builds an array where every section has the same number of entries. @param chains First section of each demand, plus one past the last section. @param width The number of entries of each section. @param value The initial value of every entry. **/
+	RaggedMatrix(const std::vector<int>& chains, const int width, const T& value = T()) : chainOffsets(chains)
+	{
+        int nbSections = chainOffsets.empty() ? 0 : chainOffsets.back();
+        sectionOffsets.resize(nbSections + 1);
+        for (int s = 0; s <= nbSections; s++){
+            sectionOffsets[s] = s * width;
+        }
+        values.assign((std::size_t)nbSections * width, value);
+    }
+
+	/** Constructor. Builds an array where sections have their own number of entries. @param chains First section of each demand, plus one past the last section. @param sections First entry of each section, plus one past the last entry. @param value The initial value of every entry. **/
+	RaggedMatrix(const std::vector<int>& chains, const std::vector<int>& sections, const T& value = T()) : chainOffsets(chains), sectionOffsets(sections)
+	{
+        values.assign(sectionOffsets.empty() ? 0 : (std::size_t)sectionOffsets.back(), value);
+    }
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the number of demands. **/
+	int         getNbDemands()                  const { return chainOffsets.empty() ? 0 : (int)chainOffsets.size() - 1; }
+    /** Returns the number of sections of demand k. **/
+	int         getNbSections(const int k)      const { return chainOffsets[k+1] - chainOffsets[k]; }
+    /** Returns the number of entries of the i-th section of demand k. **/
+	int         getNbEntries(const int k, const int i) const { int s = chainOffsets[k] + i; return sectionOffsets[s+1] - sectionOffsets[s]; }
+    /** Returns the total number of entries. **/
+	std::size_t size()                          const { return values.size(); }
+
+    /** Returns the position in the array of entry (k,i,v). **/
+	int         index(const int k, const int i, const int v) const { return sectionOffsets[chainOffsets[k] + i] + v; }
+    /** Returns the position in the array of the first entry of demand k. **/
+	int         begin(const int k)              const { return sectionOffsets[chainOffsets[k]]; }
+    /** Returns the position in the array one past the last entry of demand k. **/
+	int         end(const int k)                const { return sectionOffsets[chainOffsets[k+1]]; }
+
+	T&          operator()(const int k, const int i, const int v)       { return values[index(k, i, v)]; }
+	const T&    operator()(const int k, const int i, const int v) const { return values[index(k, i, v)]; }
+	T&          operator[](const std::size_t n)                          { return values[n]; }
+	const T&    operator[](const std::size_t n)                    const { return values[n]; }
+
+    /** Returns the first entry of the i-th section of demand k. **/
+	T*          section(const int k, const int i)                        { return values.data() + index(k, i, 0); }
+	const T*    section(const int k, const int i)                  const { return values.data() + index(k, i, 0); }
+    /** Returns the first entry of the array. **/
+	T*          data()                                                   { return values.data(); }
+	const T*    data()                                             const { return values.data(); }
+};
+
+#endif
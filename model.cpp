@@ -2,7 +2,7 @@
 
 /* Constructor */
 Model::Model(const IloEnv& env_, const Data& data_) : 
-                env(env_), model(env), cplex(model), data(data_), 
+                env(env_), model(env), cplex(model), data(data_), hot(data_.getHotData()), 
                 obj(env), constraints(env)
 {
 
@@ -11,6 +11,9 @@ Model::Model(const IloEnv& env_, const Data& data_) :
     setObjective();  
     setConstraints();  
     setCplexParameters();
+    if (hasNames()){
+        cplex.exportModel(data.getInput().getLpFile().c_str());
+    }
 
     std::cout << "\t Model was correctly built ! " << std::endl;                 
 }
@@ -19,7 +22,7 @@ Model::Model(const IloEnv& env_, const Data& data_) :
 /** Set up the Cplex parameters. **/
 void Model::setCplexParameters(){
     /** Callback definitions **/
-    callback = new Callback(env, data, x);
+    callback = new Callback(env, data, x, y, cplex.getNumCores());
     CPXLONG contextmask = 0;
 	contextmask |= IloCplex::Callback::Context::Id::Candidate;
 	contextmask |= IloCplex::Callback::Context::Id::Relaxation;
@@ -30,53 +33,44 @@ void Model::setCplexParameters(){
 	
     //cplex.setParam(IloCplex::Param::Threads, 1); // Treads limited
 }
-/* Set up variables */
+/* Set up variables. Every variable is created in a single array, x first, and added at once; names are only given for LP export. */
 void Model::setVariables(){
 
     std::cout << "\t Setting up variables... " << std::endl;
+    const IloNumVar::Type type = data.getInput().isRelaxation() ? ILOFLOAT : ILOINT;
+    x = IloNumVar3DMatrix(hot.getChainOffsets(), hot.getCandidateOffsets());
+    const IloInt yOffset = (IloInt)x.size();
+    columns = IloNumVarArray(env, yOffset + (IloInt)hot.getNbNodes() * hot.getNbVnfs(), 0.0, 1.0, type);
 
     /* VNF placement variables */
-    y.resize(lemon::countNodes(data.getGraph()));
-    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-        int v = data.getNodeId(n);
-        y[v].resize(data.getNbVnfs());
-        for (int f = 0; f < data.getNbVnfs(); f++){
-            int vnf = data.getVnf(f).getId();
-            std::string name = "y(" + std::to_string(v) + "," + std::to_string(vnf) + ")";
-            if (data.getInput().isRelaxation()){
-                y[v][f] = IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str());
-            }
-            else{
-                y[v][f] = IloNumVar(env, 0.0, 1.0, ILOINT, name.c_str());
+    y.resize(hot.getNbNodes());
+    for (int v = 0; v < hot.getNbNodes(); v++){
+        y[v].resize(hot.getNbVnfs());
+        for (int f = 0; f < hot.getNbVnfs(); f++){
+            y[v][f] = columns[yOffset + (IloInt)v * hot.getNbVnfs() + f];
+            if (hasNames()){
+                std::string name = "y(" + std::to_string(v) + "," + std::to_string(f) + ")";
+                y[v][f].setName(name.c_str());
             }
-            model.add(y[v][f]);
         }
     }
 
-    /* VNF assignment variables */
-    x.resize(data.getNbDemands());
-    for (int k = 0; k < data.getNbDemands(); k++){
-        x[k].resize(data.getDemand(k).getNbVNFs());
-        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            x[k][i].resize(lemon::countNodes(data.getGraph()));
-            for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                int v = data.getNodeId(n);
-                std::string name = "x(" + std::to_string(v) + "," + std::to_string(i) + "," + std::to_string(data.getDemand(k).getId()) + ")";
-                if (data.getInput().isRelaxation()){
-                    x[k][i][v] = IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str());
-                }
-                else{
-                    x[k][i][v] = IloNumVar(env, 0.0, 1.0, ILOINT, name.c_str());
+    /* VNF assignment variables, in the storage order of x: only the candidate nodes of each section have one. */
+    std::cout << "\t Presolve kept " << x.size() << " assignment variables out of " << (std::size_t)hot.getNbSections() * hot.getNbNodes() << "." << std::endl;
+    for (std::size_t n = 0; n < x.size(); n++){
+        x[n] = columns[(IloInt)n];
+    }
+    if (hasNames()){
+        for (int k = 0; k < hot.getNbDemands(); k++){
+            for (int i = 0; i < hot.getNbSections(k); i++){
+                for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                    std::string name = "x(" + std::to_string(hot.getCandidate(k, i, p)) + "," + std::to_string(i) + "," + std::to_string(k) + ")";
+                    x(k, i, p).setName(name.c_str());
                 }
-                model.add(x[k][i][v]);
             }
         }
     }
-    
-    
-    /* TODO: SFC routing variables */
-
-    
+    model.add(columns);
 }
 
 /* Set up objective function. */
@@ -84,27 +78,27 @@ void Model::setObjective(){
 
     std::cout << "\t Setting up objective function... " << std::endl;
 
-	IloExpr exp(env);
     /*** Objective: minimize VNF placement cost ***/
-	for(NodeIt n(data.getGraph()); n != lemon::INVALID; ++n) {
-        int v = data.getNodeId(n);
-        for (int i = 0; i < data.getNbVnfs(); i++){
-            int f = data.getVnf(i).getId();
-            double cost = data.getVnf(i).getPlacementCostOnNode(v);
-            exp += ( cost*y[v][f] ); 
+    IloNumVarArray vars(env);
+    IloNumArray costs(env);
+	for (int v = 0; v < hot.getNbNodes(); v++){
+        for (int f = 0; f < hot.getNbVnfs(); f++){
+            vars.add(y[v][f]);
+            costs.add(hot.getPlacementCost(f, v));
         }
     }
-	obj.setExpr(exp);
 	obj.setSense(IloObjective::Minimize);
+	obj.setLinearCoefs(vars, costs);
     model.add(obj);
-	exp.clear();
-    exp.end();
+    vars.end();
+    costs.end();
 }
 
-/* Set up constraints. */
+/* Set up constraints. The rows of each family are filled by the build threads, which are stopped once every family is added. */
 void Model::setConstraints(){
 
     std::cout << "\t Setting up constraints... " << std::endl;
+    builders.reset(new WorkerPool(data.getInput().getBuildThreads()));
 
     setVnfAssignmentConstraints();
 
@@ -114,136 +108,320 @@ void Model::setConstraints(){
     setNodeCapacityConstraints();
     setStrongNodeCapacityConstraints();
 
-
+    builders.reset();
     model.add(constraints);
 }
 
-/* Add up the original aggregated VNF placement constraints. */
-void Model::setOriginalVnfPlacementConstraints()
+/* Adds a family of rows. Workers take chunks of consecutive blocks from a shared counter and fill one buffer per chunk; Concert is then only touched by the calling thread, which adds the chunks in order so that rows keep the same order whatever the number of threads. */
+void Model::addRows(const int nbBlocks, const std::function<void(const int, SparseRows&)>& fill, const std::function<std::string(const int)>& name)
 {
-    for (int f = 0; f < data.getNbVnfs(); f++){
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            int v = data.getNodeId(n);
-            IloExpr exp(env);
-            for (int k = 0; k < data.getNbDemands(); k++){
-                for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                    int f_ik = data.getDemand(k).getVNF_i(i);
-                    if (f_ik == f){
-                        exp += x[k][i][v];
-                    }
+    const int nbChunks = (nbBlocks + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE;
+    std::vector<SparseRows> chunks(nbChunks);
+    std::atomic<int> next(0);
+    {
+        std::lock_guard<std::mutex> guard(builders->getLock());
+        builders->run([&](const int){
+            for (int c = next++; c < nbChunks; c = next++){
+                const int last = std::min(nbBlocks, (c + 1) * BUILD_CHUNK_SIZE);
+                for (int b = c * BUILD_CHUNK_SIZE; b < last; b++){
+                    fill(b, chunks[c]);
                 }
             }
-            int bigM = 0;
-            for (int k = 0; k < data.getNbDemands(); k++){
-                bigM += data.getDemand(k).getNbVNFs();
+        });
+    }
+
+    IloNumVarArray vars(env);
+    IloNumArray coefs(env);
+    for (int c = 0; c < nbChunks; c++){
+        const SparseRows& rows = chunks[c];
+        for (int r = 0; r < rows.getNbRows(); r++){
+            for (int n = rows.begin(r); n < rows.end(r); n++){
+                vars.add(columns[rows.getIndex(n)]);
+                coefs.add(rows.getValue(n));
             }
-            exp -= (bigM * y[v][f]);
-            std::string name = "Original_VNF_Placement(" + std::to_string(f) + "," + std::to_string(v) + ")";
-            constraints.add(IloRange(env, -IloInfinity, exp, 0, name.c_str()));
-            exp.clear();
-            exp.end();
+            addRow(rows.getLower(r), rows.getUpper(r), vars, coefs, hasNames() ? name(rows.getId(r)) : "");
         }
+        /* Free the chunk as soon as it is in Concert. */
+        chunks[c] = SparseRows();
     }
+    vars.end();
+    coefs.end();
 }
-/* Add up the VNF placement constraints: a VNF can only be assigned to a demand if it is already placed. */
-void Model::setVnfPlacementConstraints()
+
+/* Adds the row lb <= sum coefs * vars <= ub to the set of constraints. The buffers are emptied. */
+void Model::addRow(const IloNum lb, const IloNum ub, IloNumVarArray& vars, IloNumArray& coefs, const std::string& name)
+{
+    IloRange range(env, lb, ub);
+    range.setLinearCoefs(vars, coefs);
+    if (hasNames()){
+        range.setName(name.c_str());
+    }
+    constraints.add(range);
+    vars.clear();
+    coefs.clear();
+}
+
+/* Add up the original aggregated VNF placement constraints. One row per (f, v). */
+void Model::setOriginalVnfPlacementConstraints()
 {
-    for (int k = 0; k < data.getNbDemands(); k++){
-        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            int f = data.getDemand(k).getVNF_i(i);
-            for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                int v = data.getNodeId(n);
-                IloExpr exp(env);
-                exp += x[k][i][v];
-                exp -= y[v][f];
-                std::string name = "VNF_Placement(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(v) + ")";
-                constraints.add(IloRange(env, -IloInfinity, exp, 0, name.c_str()));
-                exp.clear();
-                exp.end();
+    const int yOffset = (int)x.size();
+    const int nbNodes = hot.getNbNodes();
+    addRows(hot.getNbVnfs() * nbNodes, [&](const int r, SparseRows& rows){
+        const int f = r / nbNodes;
+        const int v = r % nbNodes;
+        /* At most every section of f can be assigned to a node. */
+        const int bigM = hot.getNbSectionsOfVnf(f);
+        for (int n = 0; n < hot.getNbColumnsOfNode(v); n++){
+            const int column = hot.getColumnOfNode(v, n);
+            if (hot.getChainVnfs()[hot.getColumnSection(column)] == f){
+                rows.add(column, 1.0);
             }
         }
-    }
+        rows.add(yOffset + v * hot.getNbVnfs() + f, -bigM);
+        rows.close(r, -IloInfinity, 0);
+    }, [&](const int r){
+        return "Original_VNF_Placement(" + std::to_string(r / nbNodes) + "," + std::to_string(r % nbNodes) + ")";
+    });
 }
 
-/* Add up the VNF assignment constraints: At least one VNF must be assigned to each section of each demand. */
+/* Add up the VNF placement constraints: a VNF can only be assigned to a demand if it is already placed. One row per variable x, in its storage order, filled section by section. */
+void Model::setVnfPlacementConstraints()
+{
+    const int yOffset = (int)x.size();
+    addRows(hot.getNbSections(), [&](const int s, SparseRows& rows){
+        const int k = hot.getSectionDemand(s);
+        const int i = hot.getSectionPosition(s);
+        const int f = hot.getSectionVnf(k, i);
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            const int column = x.index(k, i, p);
+            rows.add(column, 1.0);
+            rows.add(yOffset + hot.getCandidate(k, i, p) * hot.getNbVnfs() + f, -1.0);
+            rows.close(column, -IloInfinity, 0);
+        }
+    }, [&](const int column){
+        const int s = hot.getColumnSection(column);
+        const int k = hot.getSectionDemand(s);
+        const int i = hot.getSectionPosition(s);
+        return "VNF_Placement(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(hot.getCandidate(k, i, column - hot.getFirstColumn(k, i))) + ")";
+    });
+}
+
+/* Add up the VNF assignment constraints: At least one VNF must be assigned to each section of each demand. One row per section. */
 void Model::setVnfAssignmentConstraints(){
-    for (int k = 0; k < data.getNbDemands(); k++){
-        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            IloExpr exp(env);
-            for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                int v = data.getNodeId(n);
-                exp += x[k][i][v];
+    addRows(hot.getNbSections(), [&](const int s, SparseRows& rows){
+        const int k = hot.getSectionDemand(s);
+        const int i = hot.getSectionPosition(s);
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            rows.add(x.index(k, i, p), 1.0);
+        }
+        rows.close(s, 2, IloInfinity);
+    }, [&](const int s){
+        return "VNF_Assignment(" + std::to_string(hot.getSectionDemand(s)) + "," + std::to_string(hot.getSectionPosition(s)) + ")";
+    });
+}
+
+
+/* Add up the node capacity constraints: the bandwidth treated in a node must respect its capacity. One row per node. */
+void Model::setNodeCapacityConstraints(){
+    addRows(hot.getNbNodes(), [&](const int v, SparseRows& rows){
+        for (int n = 0; n < hot.getNbColumnsOfNode(v); n++){
+            const int column = hot.getColumnOfNode(v, n);
+            rows.add(column, hot.getSectionLoads()[hot.getColumnSection(column)]);
+        }
+        rows.close(v, 0, hot.getCapacity(v));
+    }, [&](const int v){
+        return "Node_Capacity(" + std::to_string(v) + ")";
+    });
+}
+
+/* Add up the strong node capacity constraints. One row per (v, f). */
+void Model::setStrongNodeCapacityConstraints(){
+    const int yOffset = (int)x.size();
+    const int nbVnfs = hot.getNbVnfs();
+    addRows(hot.getNbNodes() * nbVnfs, [&](const int r, SparseRows& rows){
+        const int v = r / nbVnfs;
+        const int f = r % nbVnfs;
+        for (int n = 0; n < hot.getNbColumnsOfNode(v); n++){
+            const int column = hot.getColumnOfNode(v, n);
+            const int s = hot.getColumnSection(column);
+            if (hot.getChainVnfs()[s] == f){
+                rows.add(column, hot.getSectionLoads()[s]);
             }
-            std::string name = "VNF_Assignment(" + std::to_string(k) + "," + std::to_string(i) + ")";
-            constraints.add(IloRange(env, 2, exp, IloInfinity, name.c_str()));
-            exp.clear();
-            exp.end();
         }
+        rows.add(yOffset + r, -hot.getCapacity(v));
+        rows.close(r, -IloInfinity, 0);
+    }, [&](const int r){
+        return "Strong_Node_Capacity(" + std::to_string(r / nbVnfs) + "," + std::to_string(r % nbVnfs) + ")";
+    });
+}
+
+/* Gives CPLEX a placement to start from. */
+void Model::addMipStart(const Placement& placement)
+{
+    /* The placement is stored in the order of the columns: x, then y. */
+    IloNumArray values(env, columns.getSize());
+    for (std::size_t n = 0; n < placement.assignment.size(); n++){
+        values[(IloInt)n] = placement.assignment[n];
     }
+    for (std::size_t m = 0; m < placement.installed.size(); m++){
+        values[(IloInt)(x.size() + m)] = placement.installed[m];
+    }
+    cplex.addMIPStart(columns, values, (IloCplex::MIPStartEffort)data.getInput().getMipStartEffort());
+    std::cout << "\t MIP start of cost " << placement.cost << " added." << std::endl;
+    values.end();
 }
 
+/* Reads the placements of a MIP start file and gives them to CPLEX. */
+int Model::loadMipStarts(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file.is_open() || file.peek() == std::ifstream::traits_type::eof()){
+        return 0;
+    }
+    file.close();
+    std::cout << "\t Reading MIP starts from " << filename << " ..." << std::endl;
 
-/* Add up the node capacity constraints: the bandwidth treated in a node must respect its capacity. */
-void Model::setNodeCapacityConstraints(){
-    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-        int v = data.getNodeId(n);
-        IloExpr exp(env);
-        double capacity = data.getNode(v).getCapacity();
-        for (int k = 0; k < data.getNbDemands(); k++){
-            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                int vnf = data.getDemand(k).getVNF_i(i);
-                double coeff = data.getDemand(k).getBandwidth() * data.getVnf(vnf).getConsumption();
-                exp += (coeff * x[k][i][v]);
+    /* Names are resolved here rather than through Data, which aborts on unknown names: the instance may have changed since the file was written. */
+    std::unordered_map<std::string, int> nodeIds, vnfIds, demandIds;
+    for (int v = 0; v < hot.getNbNodes(); v++){
+        nodeIds[data.getNode(v).getName()] = v;
+    }
+    for (int f = 0; f < hot.getNbVnfs(); f++){
+        vnfIds[data.getVnf(f).getName()] = f;
+    }
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        demandIds[data.getDemand(k).getName()] = k;
+    }
+    auto find = [](const std::unordered_map<std::string, int>& ids, const std::string& name){
+        auto search = ids.find(name);
+        return (search != ids.end()) ? search->second : -1;
+    };
+
+    int nbStarts = 0;
+    int nbSkipped = 0;
+    bool open = false;
+    bool valid = false;
+    Placement placement;
+    auto flush = [&](){
+        if (open && valid){
+            placement.cost = 0.0;
+            for (int v = 0; v < hot.getNbNodes(); v++){
+                for (int f = 0; f < hot.getNbVnfs(); f++){
+                    placement.cost += placement.installed[(std::size_t)v * hot.getNbVnfs() + f] * hot.getPlacementCost(f, v);
+                }
             }
+            addMipStart(placement);
+            nbStarts++;
         }
-        std::string name = "Node_Capacity(" + std::to_string(v) + ")";
-        constraints.add(IloRange(env, 0, exp, capacity, name.c_str()));
-        exp.clear();
-        exp.end();
+        else if (open){
+            nbSkipped++;
+        }
+    };
+
+    /* The file is optional: a file that cannot be read is skipped, as a whole. */
+    try {
+        Reader reader(filename);
+        reader.forEachRow([&](const Row& row){
+            const std::string type = row[0].str();
+            if (type == "solution"){
+                flush();
+                open = true;
+                valid = true;
+                placement.assignment = RaggedMatrix<IloNum>(hot.getChainOffsets(), hot.getCandidateOffsets(), 0.0);
+                placement.installed.assign((std::size_t)hot.getNbNodes() * hot.getNbVnfs(), 0.0);
+            }
+            else if (open && type == "y" && row.size() >= 3){
+                int v = find(nodeIds, row[1].str());
+                int f = find(vnfIds, row[2].str());
+                if (v == -1 || f == -1){
+                    valid = false;
+                    return;
+                }
+                placement.installed[(std::size_t)v * hot.getNbVnfs() + f] = 1.0;
+            }
+            else if (open && type == "x" && row.size() >= 4){
+                int k = find(demandIds, row[1].str());
+                int i = row[2].toInt();
+                int v = find(nodeIds, row[3].str());
+                int p = (k == -1 || v == -1 || i < 0 || i >= hot.getNbSections(k)) ? -1 : hot.getCandidatePosition(k, i, v);
+                if (p == -1){
+                    valid = false;
+                    return;
+                }
+                placement.assignment(k, i, p) = 1.0;
+                placement.installed[(std::size_t)v * hot.getNbVnfs() + hot.getSectionVnf(k, i)] = 1.0;
+            }
+            else{
+                valid = false;
+            }
+        });
     }
+    catch (const std::runtime_error& e) {
+        std::cout << "WARNING: " << e.what() << " No MIP start was read." << std::endl;
+        return 0;
+    }
+    flush();
+    if (nbSkipped > 0){
+        std::cout << "WARNING: " << nbSkipped << " MIP starts of " << filename << " do not match the instance and were skipped." << std::endl;
+    }
+    return nbStarts;
 }
 
-/* Add up the strong node capacity constraints. */
-void Model::setStrongNodeCapacityConstraints(){
-    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-        int v = data.getNodeId(n);
-        double capacity = data.getNode(v).getCapacity();
-        for (int f = 0; f < data.getNbVnfs(); f++){
-            IloExpr exp(env);
-            for (int k = 0; k < data.getNbDemands(); k++){
-                for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-                    int vnf = data.getDemand(k).getVNF_i(i);
-                    if (vnf == f){
-                        double coeff = data.getDemand(k).getBandwidth() * data.getVnf(vnf).getConsumption();
-                        exp += (coeff * x[k][i][v]);
-                    }
+/* Writes the best solution found into a MIP start file: one row per variable set to one. */
+void Model::saveMipStart(const std::string& filename)
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to create MIP start file '" << filename << "'." << std::endl;
+        return;
+    }
+    file << "Type;Name;Section;Node" << std::endl;
+    file << "solution;" << cplex.getObjValue() << std::endl;
+    for (int v = 0; v < hot.getNbNodes(); v++){
+        for (int f = 0; f < hot.getNbVnfs(); f++){
+            if (cplex.getValue(y[v][f]) > 1 - EPS){
+                file << "y;" << data.getNode(v).getName() << ";" << data.getVnf(f).getName() << std::endl;
+            }
+        }
+    }
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        for (int i = 0; i < hot.getNbSections(k); i++){
+            for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                if (cplex.getValue(x(k, i, p)) > 1 - EPS){
+                    file << "x;" << data.getDemand(k).getName() << ";" << i << ";" << data.getNode(hot.getCandidate(k, i, p)).getName() << std::endl;
                 }
             }
-            exp -= ( capacity * y[v][f]);
-            std::string name = "Strong_Node_Capacity(" + std::to_string(v) + "," + std::to_string(f) + ")";
-            constraints.add(IloRange(env, -IloInfinity, exp, 0, name.c_str()));
-            exp.clear();
-            exp.end();
         }
     }
+    file.close();
+    std::cout << "\t Best solution written to " << filename << "." << std::endl;
 }
 
 void Model::run()
 {
+    const std::string& mipStartFile = data.getInput().getMipStartFile();
+    if (!mipStartFile.empty() && !data.getInput().isRelaxation()){
+        loadMipStarts(mipStartFile);
+    }
     time = cplex.getCplexTime();
 	cplex.solve();
 
 	/* Get final execution time */
 	time = cplex.getCplexTime() - time;
+
+    /* Keep the best solution for the next run */
+    if (!mipStartFile.empty() && !data.getInput().isRelaxation() && 
+        (cplex.getStatus() == IloCplex::Feasible || cplex.getStatus() == IloCplex::Optimal)){
+        saveMipStart(mipStartFile);
+    }
 }
 
 void Model::printResult(){
     
     std::cout << "=> VNF placement solution ..." << std::endl;
-    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-        int v = data.getNodeId(n);
+    for (int v = 0; v < hot.getNbNodes(); v++){
         std::string vnfs;
-        for (int f = 0; f < data.getNbVnfs(); f++){
+        for (int f = 0; f < hot.getNbVnfs(); f++){
             if (cplex.getValue(y[v][f]) > 1 - EPS){
                 vnfs += data.getVnf(f).getName();
                 vnfs += ", ";
@@ -262,6 +440,8 @@ void Model::printResult(){
     std::cout << "User cuts added: " << callback->getNbUserCuts() << std::endl;
     std::cout << "Lazy constraints added: " << callback->getNbLazyConstraints() << std::endl;
     std::cout << "Time on cuts: " << callback->getTime() << std::endl;
+    callback->getStats().print();
+    callback->getCutPool().print();
     std::cout << "Total time: " << time << std::endl << std::endl;
 
 
@@ -296,4 +476,5 @@ void Model::printResult(){
 /****************************************************************************************/
 Model::~Model(){
     delete callback;
+    columns.end();
 }
\ No newline at end of file
@@ -8,6 +8,17 @@
 
 /*** Own Libraries ***/
 #include "callback.hpp"
+#include "heuristic.hpp"
+#include "../tools/sparserows.hpp"
+#include "../tools/workerpool.hpp"
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/** Number of blocks of rows of a family filled by a worker in one go when building the model. **/
+#define BUILD_CHUNK_SIZE 256
 
 /****************************************************************************************/
 /*										TYPEDEFS										*/
@@ -16,15 +27,11 @@
 /*** CPLEX ***/	
 typedef std::vector<IloNumVar>          IloNumVarVector;
 typedef std::vector<IloNumVarVector>    IloNumVarMatrix;
-typedef std::vector<IloNumVarMatrix>    IloNumVar3DMatrix;
-typedef std::vector<IloNumVar3DMatrix>  IloNumVar4DMatrix;
-typedef std::vector<IloNumVar4DMatrix>  IloNumVar5DMatrix;
+typedef RaggedMatrix<IloNumVar>         IloNumVar3DMatrix;
 
 typedef std::vector<IloNum>            IloNumVector;
 typedef std::vector<IloNumVector>      IloNumMatrix;
-typedef std::vector<IloNumMatrix>      IloNum3DMatrix;
-typedef std::vector<IloNum3DMatrix>    IloNum4DMatrix;
-typedef std::vector<IloNum4DMatrix>    IloNum5DMatrix;
+typedef RaggedMatrix<IloNum>           IloNum3DMatrix;
 
 
 /********************************************************************************************
@@ -39,13 +46,16 @@ class Model
 	 	IloModel        model;  /**< IBM Model **/
 		IloCplex        cplex;  /**< IBM Cplex **/
 		const Data&     data;   /**< Data read in data.hpp **/
+		const HotData&  hot;    /**< Contiguous view of the data used while building the model **/
 
 		/*** Formulation specific ***/
 		IloNumVarMatrix 	y;              /**< VNF placement variables **/
-		IloNumVar3DMatrix 	x;            	/**< VNF assignement variables **/
+		IloNumVar3DMatrix 	x;            	/**< VNF assignement variables, x(k,i,p) being the assignment of the i-th section of demand k to its p-th candidate node **/
+		IloNumVarArray 		columns;        /**< Every variable: x in its storage order, then y[v][f] at position x.size() + v*|F| + f **/
 		IloObjective    	obj;            /**< Objective function **/
 		IloRangeArray   	constraints;    /**< Set of constraints **/
 		Callback* 			callback; 		/**< User generic callback **/
+		std::unique_ptr<WorkerPool> builders; /**< Threads filling the constraint rows, only alive while the constraints are built **/
 
 		/*** Manage execution and control ***/
 		IloNum time;
@@ -80,10 +90,25 @@ class Model
         void setNodeCapacityConstraints();
         /** Add up the strong node capacity constraints. **/
         void setStrongNodeCapacityConstraints();
+        /** Adds a family of rows split into nbBlocks blocks: fill(b, rows) is called once for every block b, possibly from several threads at once, and closes the rows of block b in the buffer it is given, using column indices; the rows are then added in order by the calling thread. @param name Returns the name of the row of the given id, only called if names are given. **/
+        void addRows(const int nbBlocks, const std::function<void(const int, SparseRows&)>& fill, const std::function<std::string(const int)>& name);
+        /** Adds the row lb <= sum coefs * vars <= ub to the set of constraints and empties the buffers. @param name The row name, only used if names are given. **/
+        void addRow(const IloNum lb, const IloNum ub, IloNumVarArray& vars, IloNumArray& coefs, const std::string& name);
+        /** Returns true if variables and constraints are named, which is only needed when the model is exported. **/
+        bool hasNames() const { return !data.getInput().getLpFile().empty(); }
 	/****************************************************************************************/
 	/*										   Methods  									*/
 	/****************************************************************************************/
-		/** Solves the MIP. **/
+		/** Gives CPLEX a placement to start from, with the effort chosen in the parameters. @param placement The placement, with a value for every x and y variable. **/
+		void addMipStart(const Placement& placement);
+
+		/** Reads the placements stored in a MIP start file and gives them to CPLEX. Placements naming nodes, vnfs, demands or sections unknown to the instance are skipped. Returns the number of MIP starts added. @param filename The file to be read; nothing is done if it does not exist. **/
+		int  loadMipStarts(const std::string& filename);
+
+		/** Writes the best solution found into a MIP start file, readable by loadMipStarts on a later run. @param filename The file to be written. **/
+		void saveMipStart(const std::string& filename);
+
+		/** Solves the MIP. The MIP start file, if any, is read before and written after. **/
 		void run();
 
 		/*** Display the obtained results ***/
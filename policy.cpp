@@ -0,0 +1,69 @@
+#include "policy.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/** Constructor. **/
+SeparationPolicy::SeparationPolicy(const Input& input, const int nbThreads_) : 
+                frequency(input.getSeparationFrequency()), maxDepth(input.getSeparationMaxDepth()), 
+                minEfficacy(input.getSeparationMinEfficacy()), timeShare(input.getSeparationTimeShare()), 
+                nbThreads(nbThreads_), startTime(-1.0), threads(nbThreads_)
+{
+    for (int t = 0; t < nbThreads; t++){
+        threads[t].backoff = 1;
+        threads[t].nbSkips = 0;
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Returns true if cuts must be separated at the current relaxation. */
+bool SeparationPolicy::shouldSeparate(const int thread, const long depth, const long nodeCount, const double now, const double callbackTime)
+{
+    double start = startTime.load(std::memory_order_relaxed);
+    if (start < 0.0){
+        startTime.compare_exchange_strong(start, now);
+        start = startTime.load(std::memory_order_relaxed);
+    }
+
+    /* Aggressive at the root. */
+    if (depth == 0){
+        return true;
+    }
+    if (maxDepth >= 0 && depth > maxDepth){
+        return false;
+    }
+    if (nodeCount % frequency != 0){
+        return false;
+    }
+
+    /* Time budget. */
+    double elapsed = (now - start) * nbThreads;
+    if (timeShare < 1.0 && elapsed > 0.0 && callbackTime > timeShare * elapsed){
+        return false;
+    }
+
+    /* Back-off. */
+    ThreadState& state = threads[thread];
+    if (state.nbSkips > 0){
+        state.nbSkips--;
+        return false;
+    }
+    return true;
+}
+
+/* Records the outcome of a separation round. */
+void SeparationPolicy::recordRound(const int thread, const int nbCuts, const double totalEfficacy)
+{
+    ThreadState& state = threads[thread];
+    if (minEfficacy > 0.0 && (nbCuts == 0 || totalEfficacy / nbCuts < minEfficacy)){
+        state.nbSkips = state.backoff;
+        state.backoff = std::min(2 * state.backoff, POLICY_MAX_BACKOFF);
+    }
+    else{
+        state.backoff = 1;
+    }
+}
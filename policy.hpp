@@ -0,0 +1,68 @@
+#ifndef __policy__hpp
+#define __policy__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+/*** Own Libraries ***/
+#include "../instance/input.hpp"
+#include "stats.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define POLICY_MAX_BACKOFF  64  // Largest number of relaxation rounds skipped after an unproductive round
+
+
+/************************************************************************************
+ * This class decides when availability cuts are separated on fractional solutions.
+ * Separation always runs at the root. Below it, it only runs every n B&C nodes and up
+ * to a maximum depth. Each thread also backs off on its own: after a round that found no
+ * cut, or whose cuts had a low mean efficacy, it skips a number of rounds that doubles with every new 
+ * unproductive round. Finally, separation stops below the root while the time spent in 
+ * the callback exceeds the given share of the threads time. Integer solutions are 
+ * always checked, since lazy constraints are needed for correctness.
+ ************************************************************************************/
+class SeparationPolicy {
+
+private:
+    /** The back-off state of one thread. **/
+    struct ThreadState {
+        char    paddingBefore[CACHE_LINE_SIZE];     /**< Keeps the state away from the previous thread's. **/
+        int     backoff;                            /**< Number of rounds to skip after the next unproductive round. **/
+        int     nbSkips;                            /**< Number of rounds left to skip. **/
+        char    paddingAfter[CACHE_LINE_SIZE];      /**< Keeps the state away from the next thread's. **/
+    };
+
+    const int               frequency;      /**< Number of B&C nodes between two separations below the root. **/
+    const int               maxDepth;       /**< Deepest B&C node where cuts are separated, or -1 for no limit. **/
+    const double            minEfficacy;    /**< Mean efficacy under which a round is unproductive. **/
+    const double            timeShare;      /**< Largest share of the threads time that may be spent in the callback. **/
+    const int               nbThreads;      /**< Number of threads. **/
+    std::atomic<double>     startTime;      /**< Time of the first invocation, or a negative value before it. **/
+    std::vector<ThreadState> threads;       /**< The state of each thread, indexed by CPLEX thread id. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param input The parameters. @param nbThreads The number of threads. **/
+    SeparationPolicy(const Input& input, const int nbThreads);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns true if cuts must be separated at the current relaxation. @param thread The calling thread. @param depth The depth of the B&C node. @param nodeCount The number of B&C nodes processed so far. @param now The current time. @param callbackTime The total time spent in the callback so far, over all threads. **/
+    bool    shouldSeparate  (const int thread, const long depth, const long nodeCount, const double now, const double callbackTime);
+
+    /** Records the outcome of a separation round, and backs off if it was unproductive. @param thread The calling thread. @param nbCuts The number of cuts added. @param totalEfficacy The sum of the efficacies of the cuts added. **/
+    void    recordRound     (const int thread, const int nbCuts, const double totalEfficacy);
+};
+
+#endif
@@ -1,5 +1,114 @@
 #include "reader.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Parses the token as a floating number, in place. */
+double Token::toDouble() const
+{
+	char buffer[64];
+	if (length >= sizeof(buffer)){
+		return atof(str().c_str());
+	}
+	std::memcpy(buffer, first, length);
+	buffer[length] = '\0';
+	return std::strtod(buffer, nullptr);
+}
+
+/* Parses the token as an integer, in place. */
+int Token::toInt() const
+{
+	char buffer[64];
+	if (length >= sizeof(buffer)){
+		return atoi(str().c_str());
+	}
+	std::memcpy(buffer, first, length);
+	buffer[length] = '\0';
+	return (int)std::strtol(buffer, nullptr, 10);
+}
+
+/* Maps the whole file in memory. */
+MappedFile::MappedFile(const std::string& filepath) : first(nullptr), length(0)
+{
+	int fd = open(filepath.c_str(), O_RDONLY);
+	struct stat info;
+	if (fd < 0 || fstat(fd, &info) != 0){
+		if (fd >= 0){
+			close(fd);
+		}
+		throw std::runtime_error("ERROR: Unable to open file " + filepath + ".");
+	}
+	length = (std::size_t)info.st_size;
+	if (length > 0){
+		void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address == MAP_FAILED){
+			close(fd);
+			throw std::runtime_error("ERROR: Unable to map file " + filepath + " in memory.");
+		}
+		madvise(address, length, MADV_SEQUENTIAL);
+		first = static_cast<const char*>(address);
+	}
+	close(fd);
+}
+
+/* Unmaps the file. */
+MappedFile::~MappedFile()
+{
+	if (first != nullptr){
+		munmap(const_cast<char*>(first), length);
+	}
+}
+
+/* Splits the line [begin, end) into non-empty trimmed tokens. */
+void Reader::tokenize(const char* begin, const char* end, Row& row) const
+{
+	row.clear();
+	const char* it = begin;
+	while (it <= end){
+		const char* next = end;
+		if (delimeter.size() == 1){
+			const void* found = std::memchr(it, delimeter[0], end - it);
+			if (found != nullptr){
+				next = static_cast<const char*>(found);
+			}
+		}
+		else{
+			next = std::search(it, end, delimeter.begin(), delimeter.end());
+		}
+		Token token = trim(Token(it, next - it));
+		if (!token.empty()){
+			row.push_back(token);
+		}
+		it = next + delimeter.size();
+	}
+}
+
+/* Maps the file and splits it into rows of tokens pointing inside the mapping. */
+TokenizedFile::TokenizedFile(const Reader& reader, const int nbHeaderLines) : file(new MappedFile(reader.getFilename())), rowOffsets(1, 0)
+{
+	Row row;
+	int nbRows = 0;
+	const char* it = file->begin();
+	const char* end = file->end();
+	while (it < end){
+		const char* eol = static_cast<const char*>(std::memchr(it, '\n', end - it));
+		if (eol == nullptr){
+			eol = end;
+		}
+		reader.tokenize(it, eol, row);
+		if (!row.empty()){
+			if (nbRows >= nbHeaderLines){
+				tokens.insert(tokens.end(), row.begin(), row.end());
+				rowOffsets.push_back(tokens.size());
+			}
+			nbRows++;
+		}
+		it = eol + 1;
+	}
+}
+
 /* Function to fetch data from a CSV File. */
 std::vector<std::vector<std::string> > Reader::getData()
 {
@@ -58,3 +167,17 @@ std::string removeSpecialChars(std::string str){
     str.end());
 	return str;
 }
+
+/* Returns the token without its leading and trailing white spaces. */
+Token trim(const Token& token)
+{
+	const char* begin = token.data();
+	const char* end = token.data() + token.size();
+	while (begin < end && std::isspace((unsigned char)*begin)){
+		begin++;
+	}
+	while (end > begin && std::isspace((unsigned char)*(end - 1))){
+		end--;
+	}
+	return Token(begin, end - begin);
+}
@@ -4,21 +4,87 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <memory>
 #include <string>
 #include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <stdexcept>
 
 /************************************************
- * This class implements a reader of .csv files. 
+ * This class implements a read-only view over a
+ * sequence of characters. It does not own the
+ * characters it points to.
+ ************************************************/
+class Token{
+private:
+	const char* 	first;		/**< The first character of the token. **/
+	std::size_t 	length;		/**< The number of characters in the token. **/
+public:
+	/** Constructor. @param f The first character. @param n The number of characters. **/
+	Token(const char* f = nullptr, std::size_t n = 0): first(f), length(n){}
+
+	/** Returns the first character of the token. **/
+	const char* 	data()  const { return first; }
+	/** Returns the number of characters in the token. **/
+	std::size_t 	size()  const { return length; }
+	/** Returns true if the token has no characters. **/
+	bool 			empty() const { return length == 0; }
+	/** Returns a copy of the token as a string. **/
+	std::string 	str()   const { return std::string(first, length); }
+
+	/** Parses the token as a floating number, in place. Behaves like atof. **/
+	double 			toDouble() const;
+	/** Parses the token as an integer, in place. Behaves like atoi. **/
+	int 			toInt() 	const;
+};
+
+/** A row of a .csv file is a list of tokens. **/
+typedef std::vector<Token> Row;
+
+/************************************************
+ * This class maps a file in memory (read-only).
+ * The mapping is released on destruction.
+ ************************************************/
+class MappedFile{
+private:
+	const char* 	first;		/**< The first character of the mapped file. **/
+	std::size_t 	length;		/**< The size of the mapped file. **/
+public:
+	/** Constructor. Maps the whole file in memory. Throws a std::runtime_error if the file cannot be mapped. @param filepath The path of the file to be mapped. **/
+	MappedFile(const std::string& filepath);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/** Returns the first character of the file. **/
+	const char* begin() const { return first; }
+	/** Returns one past the last character of the file. **/
+	const char* end()   const { return first + length; }
+	/** Returns the size of the file in bytes. **/
+	std::size_t size()  const { return length; }
+
+	/** Destructor. Unmaps the file. **/
+	~MappedFile();
+};
+
+/************************************************
+ * This class implements a reader of .csv files.
  * It is used for reading the input files.
  ************************************************/
 class Reader{
 private:
 	const std::string filename; 	/**< The file to be read. **/
 	const std::string delimeter;	/**< The delimiter used for separating data. **/
+
+	/** Splits the line [begin, end) into non-empty trimmed tokens. @param begin The first character of the line. @param end One past the last character of the line. @param row The row to be filled. **/
+	void tokenize(const char* begin, const char* end, Row& row) const;
+
+	friend class TokenizedFile;
 public:
 	/** Constructor. @param filepath The path of the file to be read. @param delm The delimiter to be used. **/
 	Reader(std::string filepath, std::string delm = ";"): filename(filepath), delimeter(delm){}
-  
+
     /** A file must be provided. **/
     Reader() = delete;
 
@@ -30,6 +96,77 @@ public:
 
 	/** Function to fetch data from a CSV File. It goes through the .csv file, line by line, and returns the data in a vector of vector of strings. **/
 	std::vector<std::vector<std::string> > getData();
+
+	/** Streams the .csv file through a memory mapping. Each non-empty line is split into tokens pointing inside the mapping and handed to the handler, so no line is ever copied. @param handler Called as handler(const Row&) for each row. @param nbHeaderLines The number of leading rows to be skipped. **/
+	template <typename RowHandler>
+	void forEachRow(RowHandler handler, const int nbHeaderLines = 1) const;
+};
+
+/* Streams the .csv file through a memory mapping. */
+template <typename RowHandler>
+void Reader::forEachRow(RowHandler handler, const int nbHeaderLines) const
+{
+	MappedFile file(filename);
+	Row row;
+	int nbRows = 0;
+	const char* it = file.begin();
+	const char* end = file.end();
+	while (it < end){
+		const char* eol = static_cast<const char*>(std::memchr(it, '\n', end - it));
+		if (eol == nullptr){
+			eol = end;
+		}
+		tokenize(it, eol, row);
+		if (!row.empty()){
+			if (nbRows >= nbHeaderLines){
+				handler(row);
+			}
+			nbRows++;
+		}
+		it = eol + 1;
+	}
+}
+
+/************************************************
+ * This class implements a read-only view over
+ * the tokens of a row of a tokenized file.
+ ************************************************/
+class RowView{
+private:
+	const Token* 	first;		/**< The first token of the row. **/
+	std::size_t 	length;		/**< The number of tokens in the row. **/
+public:
+	/** Constructor. @param f The first token. @param n The number of tokens. **/
+	RowView(const Token* f, std::size_t n): first(f), length(n){}
+
+	/** Returns the number of tokens in the row. **/
+	std::size_t 	size() const { return length; }
+	/** Returns the n-th token of the row. **/
+	const Token& 	operator[](const std::size_t n) const { return first[n]; }
+};
+
+/************************************************
+ * This class holds a .csv file split into rows
+ * of tokens. The tokens point inside a memory
+ * mapping of the file, which lives as long as
+ * the object: a file can be tokenized by one
+ * thread and its rows interpreted by another.
+ ************************************************/
+class TokenizedFile{
+private:
+	std::unique_ptr<MappedFile> 	file;		/**< The mapping the tokens point into. **/
+	std::vector<Token> 				tokens;		/**< The tokens of every row, concatenated. **/
+	std::vector<std::size_t> 		rowOffsets;	/**< Position of the first token of each row in tokens, plus a final end offset. **/
+public:
+	/** Constructor. A file without rows. **/
+	TokenizedFile(): rowOffsets(1, 0){}
+	/** Constructor. Maps the file read by reader and splits it into rows. Throws a std::runtime_error if the file cannot be mapped. @param reader The reader of the file. @param nbHeaderLines The number of leading rows to be skipped. **/
+	TokenizedFile(const Reader& reader, const int nbHeaderLines = 1);
+
+	/** Returns the number of rows. **/
+	std::size_t 	getNbRows() 				  const { return rowOffsets.size() - 1; }
+	/** Returns the r-th row. **/
+	RowView 		getRow(const std::size_t r) const { return RowView(tokens.data() + rowOffsets[r], rowOffsets[r+1] - rowOffsets[r]); }
 };
 
 /****************************************************************
@@ -42,6 +179,30 @@ std::string getInBetweenString(std::string str, std::string firstDelimiter, std:
 /** Splits a given string by a delimiter and returns a vector of strings. @param str The string to split. @param delimiter The delimiter. For instance, "1;2;3" becomes vector {1, 2, 3} if delimiter is ";". **/
 std::vector<std::string> split(std::string str, std::string delimiter);
 
+/** Returns the token without its leading and trailing white spaces. @param token The token to be trimmed. **/
+Token trim(const Token& token);
+
+/** Splits a token by a delimiter and hands each non-empty trimmed piece to the handler, without copying. @param token The token to split. @param delimiter The delimiter. @param handler Called as handler(const Token&) for each piece. **/
+template <typename TokenHandler>
+void forEachSubToken(const Token& token, const char delimiter, TokenHandler handler)
+{
+	if (token.empty()){
+		return;
+	}
+	const char* it = token.data();
+	const char* end = token.data() + token.size();
+	while (it <= end){
+		const char* next = static_cast<const char*>(std::memchr(it, delimiter, end - it));
+		if (next == nullptr){
+			next = end;
+		}
+		Token piece = trim(Token(it, next - it));
+		if (!piece.empty()){
+			handler(piece);
+		}
+		it = next + 1;
+	}
+}
 
 std::string removeSpecialChars(std::string str);
 #endif
\ No newline at end of file
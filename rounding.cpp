@@ -0,0 +1,141 @@
+#include "rounding.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+RoundingHeuristic::RoundingHeuristic(const HotData& hot_) : hot(hot_), cost(0.0)
+{
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Builds a feasible placement guided by xSol, demand by demand. */
+bool RoundingHeuristic::round(const RaggedMatrix<IloNum>& xSol)
+{
+    if (placement.size() == 0){
+        placement = RaggedMatrix<IloNum>(hot.getChainOffsets(), hot.getCandidateOffsets(), 0.0);
+        candidates.reserve(hot.getMaxCandidates());
+    }
+    std::fill(placement.data(), placement.data() + placement.size(), 0.0);
+    installed.assign((std::size_t)hot.getNbNodes() * hot.getNbVnfs(), 0.0);
+    residualCapacity = hot.getCapacities();
+    cost = 0.0;
+
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        if (!roundDemand(k, xSol) || !repairDemand(k) || !isAvailable(k)){
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Assigns the i-th section of demand k to its p-th candidate node. */
+void RoundingHeuristic::place(const int k, const int i, const int p)
+{
+    const int f = hot.getSectionVnf(k, i);
+    const int v = hot.getCandidate(k, i, p);
+    placement(k, i, p) = 1.0;
+    residualCapacity[v] -= hot.getSectionLoad(k, i);
+    if (installed[(std::size_t)v * hot.getNbVnfs() + f] == 0.0){
+        installed[(std::size_t)v * hot.getNbVnfs() + f] = 1.0;
+        cost += hot.getPlacementCost(f, v);
+    }
+    nbSectionNodes[i]++;
+    sectionLogFailure[i] += hot.getLogFailure(v);
+    sectionLogAvailability[i] = getLogAvailabilityFromLogFailure(sectionLogFailure[i]);
+}
+
+/* Rounds the sections of demand k: values above the threshold first, then the best nodes until the section has enough of them. */
+bool RoundingHeuristic::roundDemand(const int k, const RaggedMatrix<IloNum>& xSol)
+{
+    nbSectionNodes.assign(hot.getNbSections(k), 0);
+    sectionLogFailure.assign(hot.getNbSections(k), 0.0);
+    sectionLogAvailability.assign(hot.getNbSections(k), -IloInfinity);
+    for (int i = 0; i < hot.getNbSections(k); i++){
+        const int f = hot.getSectionVnf(k, i);
+        const IloNum* values = xSol.section(k, i);
+
+        /* Ties go to nodes where the vnf is already installed, then to the most available ones. */
+        candidates.clear();
+        for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+            candidates.push_back(p);
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](const int p, const int q){
+            if (values[p] != values[q]){
+                return values[p] > values[q];
+            }
+            const int u = hot.getCandidate(k, i, p);
+            const int v = hot.getCandidate(k, i, q);
+            const IloNum installedU = installed[(std::size_t)u * hot.getNbVnfs() + f];
+            const IloNum installedV = installed[(std::size_t)v * hot.getNbVnfs() + f];
+            if (installedU != installedV){
+                return installedU > installedV;
+            }
+            return hot.getAvailability(u) > hot.getAvailability(v);
+        });
+
+        for (unsigned int n = 0; n < candidates.size(); n++){
+            const int p = candidates[n];
+            if (nbSectionNodes[i] >= ROUNDING_MIN_NODES && values[p] < ROUNDING_THRESHOLD){
+                break;
+            }
+            if (residualCapacity[hot.getCandidate(k, i, p)] >= hot.getSectionLoad(k, i)){
+                place(k, i, p);
+            }
+        }
+        if (nbSectionNodes[i] < ROUNDING_MIN_NODES){
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Adds the placements of best availability gain per unit of new cost until the chain availability of demand k is met. */
+bool RoundingHeuristic::repairDemand(const int k)
+{
+    const double LOG_REQUIRED_AVAIL = hot.getLogRequiredAvailability(k);
+    double chainLogAvailability = sumLogValues(sectionLogAvailability.data(), hot.getNbSections(k));
+    while (chainLogAvailability < LOG_REQUIRED_AVAIL){
+        int bestSection = -1;
+        int bestPosition = -1;
+        double bestScore = 0.0;
+        for (int i = 0; i < hot.getNbSections(k); i++){
+            const int f = hot.getSectionVnf(k, i);
+            for (int p = 0; p < hot.getNbCandidates(k, i); p++){
+                const int v = hot.getCandidate(k, i, p);
+                if (placement(k, i, p) == 1.0 || residualCapacity[v] < hot.getSectionLoad(k, i)){
+                    continue;
+                }
+                double gain = getLogAvailabilityFromLogFailure(sectionLogFailure[i] + hot.getLogFailure(v)) - sectionLogAvailability[i];
+                double newCost = (installed[(std::size_t)v * hot.getNbVnfs() + f] == 0.0) ? hot.getPlacementCost(f, v) : 0.0;
+                double score = gain / (1.0 + newCost);
+                if (score > bestScore){
+                    bestScore = score;
+                    bestSection = i;
+                    bestPosition = p;
+                }
+            }
+        }
+        if (bestSection == -1){
+            return false;
+        }
+        place(k, bestSection, bestPosition);
+        chainLogAvailability = sumLogValues(sectionLogAvailability.data(), hot.getNbSections(k));
+    }
+    return true;
+}
+
+/* Checks the chain availability of demand k with the kernels of the lazy constraints, in section order. */
+bool RoundingHeuristic::isAvailable(const int k)
+{
+    sectionLogAvailability.resize(hot.getNbSections(k));
+    for (int i = 0; i < hot.getNbSections(k); i++){
+        double logFailure = sumLogFailureMasked(hot.getCandidateLogFailures().data() + hot.getFirstColumn(k, i), placement.section(k, i), hot.getNbCandidates(k, i), ROUNDING_THRESHOLD);
+        sectionLogAvailability[i] = getLogAvailabilityFromLogFailure(logFailure);
+    }
+    return (sumLogValues(sectionLogAvailability.data(), hot.getNbSections(k)) >= hot.getLogRequiredAvailability(k));
+}
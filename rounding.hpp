@@ -0,0 +1,79 @@
+#ifndef __rounding__hpp
+#define __rounding__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <algorithm>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+
+/*** Own Libraries ***/
+#include "../instance/hotdata.hpp"
+#include "../tools/matrix.hpp"
+#include "../tools/availability.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define ROUNDING_THRESHOLD      0.5     // Placements with a larger value are rounded up when they fit
+#define ROUNDING_MIN_NODES      2       // Number of nodes every section must be assigned to
+
+
+/****************************************************************************************
+ * This class builds a feasible placement from a fractional solution. Demands are handled
+ * one after the other, against the capacity left by the previous ones:
+ *  - rounding: each section is assigned to the nodes where its value is above 
+ *    ROUNDING_THRESHOLD, by decreasing value, and then to the best remaining nodes until
+ *    it has ROUNDING_MIN_NODES of them, as long as they have capacity left;
+ *  - repair: while the chain availability is below the requirement, the placement with
+ *    the best availability gain per unit of new placement cost is added.
+ * The chain availability is finally checked with the kernels of the lazy constraints, so 
+ * a placement returned is never rejected by them.
+****************************************************************************************/
+class RoundingHeuristic {
+
+private:
+    const HotData&          hot;                /**< The instance data. **/
+
+    /*** Buffers ***/
+    std::vector<double>     residualCapacity;   /**< Capacity left on each node. **/
+    std::vector<int>        candidates;         /**< Positions of the candidates of the current section, by decreasing value. **/
+    std::vector<int>        nbSectionNodes;     /**< Number of nodes each section of the current demand is assigned to. **/
+    std::vector<double>     sectionLogFailure;  /**< Logarithm of the failure probability of each section of the current demand. **/
+    std::vector<double>     sectionLogAvailability; /**< Logarithm of the availability of each section of the current demand. **/
+
+    /** Assigns the i-th section of demand k to its p-th candidate node and installs its vnf there if needed. **/
+    void    place(const int k, const int i, const int p);
+    /** Rounds the sections of demand k. Returns false if some section cannot be assigned to enough nodes. **/
+    bool    roundDemand(const int k, const RaggedMatrix<IloNum>& xSol);
+    /** Adds placements to demand k until its chain availability is met. Returns false if no placement fits. **/
+    bool    repairDemand(const int k);
+
+public:
+    /*** Result ***/
+    RaggedMatrix<IloNum>    placement;          /**< placement(k, i, p) is 1 if the i-th section of demand k is assigned to its p-th candidate node, 0 otherwise. Stored in the order of the columns. **/
+    std::vector<IloNum>     installed;          /**< 1 if vnf f is installed on node v, stored at v * nbVnfs + f. **/
+    double                  cost;               /**< Placement cost of the solution. **/
+
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+    /** Constructor. The result buffers are allocated on the first call to round. @param hot The instance data. **/
+    RoundingHeuristic(const HotData& hot);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Builds a feasible placement guided by xSol. Returns false if none was found, in which case the result is meaningless. @param xSol The solution guiding the placement, over all demands, one value per column. **/
+    bool    round(const RaggedMatrix<IloNum>& xSol);
+
+    /** Returns true if the chain availability of demand k in the current placement meets its requirement. **/
+    bool    isAvailable(const int k);
+};
+
+#endif
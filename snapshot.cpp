@@ -0,0 +1,57 @@
+#include "snapshot.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../tools/fingerprint.hpp"
+
+/****************************************************************************************/
+/*										Layout											*/
+/****************************************************************************************/
+
+/* Rounds a byte offset up to the next multiple of 8. */
+static uint64_t align8(const uint64_t offset)
+{
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+/** Constructor. Computes the sections positions. **/
+SnapshotLayout::SnapshotLayout(const SnapshotHeader& header)
+{
+    nodes            = align8(sizeof(SnapshotHeader));
+    links            = align8(nodes + header.nbNodes * sizeof(SnapshotNode));
+    vnfs             = align8(links + header.nbLinks * sizeof(SnapshotLink));
+    demands          = align8(vnfs + header.nbVnfs * sizeof(SnapshotVnf));
+    placementCost    = align8(demands + header.nbDemands * sizeof(SnapshotDemand));
+    chains           = align8(placementCost + (uint64_t)header.nbVnfs * header.nbNodes * sizeof(double));
+    strings          = align8(chains + header.nbChainEntries * sizeof(int32_t));
+    total            = strings + header.stringsSize;
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Returns a fingerprint of the input files (paths, sizes and modification times). */
+uint64_t getInputFingerprint(const Input& params)
+{
+    const std::string files[] = { params.getNodeFile(), params.getLinkFile(), params.getVnfFile(), params.getDemandFile() };
+    uint64_t hash = FINGERPRINT_SEED;
+    for (const std::string& file : files){
+        hash = mixFingerprint(hash, file.data(), file.size());
+        struct stat info;
+        if (stat(file.c_str(), &info) == 0){
+            int64_t size = (int64_t)info.st_size;
+            int64_t modification = (int64_t)info.st_mtime;
+            hash = mixFingerprint(hash, &size, sizeof(size));
+            hash = mixFingerprint(hash, &modification, sizeof(modification));
+        }
+    }
+    return hash;
+}
+
+/* Returns true if the given file exists and can be read. */
+bool isReadable(const std::string& filename)
+{
+    return (access(filename.c_str(), R_OK) == 0);
+}
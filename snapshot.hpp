@@ -0,0 +1,114 @@
+#ifndef __snapshot__hpp
+#define __snapshot__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*** Own Libraries ***/
+#include "input.hpp"
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define SNAPSHOT_MAGIC      "R5GSNAP"   /**< Identifies a snapshot file. **/
+#define SNAPSHOT_VERSION    2           /**< Bumped whenever the layout below changes. **/
+#define SNAPSHOT_ENDIANNESS 0x01020304  /**< Detects snapshots written on a machine with another byte order. **/
+
+/********************************************************************************************
+ * A snapshot is the binary image of a fully built Data object. It is made of a header
+ * followed by fixed-size sections, each one starting on an 8-byte boundary so that it can
+ * be read in place from a memory mapping:
+ *  - nodes[nbNodes], links[nbLinks], vnfs[nbVnfs], demands[nbDemands];
+ *  - placementCost[nbVnfs * nbNodes], row f holding the costs of vnf f on every node;
+ *  - chains[nbChainEntries], the VNF ids of every demand, concatenated;
+ *  - strings[stringsSize], the names of all the objects, concatenated.
+ * The network graph is not stored: it is rebuilt from the links in O(|V| + |L|).
+********************************************************************************************/
+
+/** Header of a snapshot file. **/
+struct SnapshotHeader {
+    char        magic[8];           /**< Always SNAPSHOT_MAGIC. **/
+    uint32_t    version;            /**< Always SNAPSHOT_VERSION. **/
+    uint32_t    endianness;         /**< Always SNAPSHOT_ENDIANNESS. **/
+    uint64_t    fingerprint;        /**< Fingerprint of the input files the snapshot was built from. **/
+    uint32_t    nbNodes;            /**< Number of nodes. **/
+    uint32_t    nbLinks;            /**< Number of links. **/
+    uint32_t    nbVnfs;             /**< Number of vnfs. **/
+    uint32_t    nbDemands;          /**< Number of demands. **/
+    uint64_t    nbChainEntries;     /**< Total number of VNFs requested over all demands. **/
+    uint64_t    stringsSize;        /**< Number of characters in the string section. **/
+};
+
+/** A node record. **/
+struct SnapshotNode {
+    double      x;                  /**< Node's x coordinate. **/
+    double      y;                  /**< Node's y coordinate. **/
+    double      capacity;           /**< Node's capacity. **/
+    double      availability;       /**< Node's availability. **/
+    uint32_t    nameOffset;         /**< Position of the name in the string section. **/
+    uint32_t    nameLength;         /**< Length of the name. **/
+};
+
+/** A link record. **/
+struct SnapshotLink {
+    int32_t     source;             /**< Link's source id. **/
+    int32_t     target;             /**< Link's target id. **/
+    double      delay;              /**< Link's delay. **/
+    double      bandwidth;          /**< Link's total bandwidth. **/
+    uint32_t    nameOffset;         /**< Position of the name in the string section. **/
+    uint32_t    nameLength;         /**< Length of the name. **/
+};
+
+/** A vnf record. Placement costs are stored in their own section. **/
+struct SnapshotVnf {
+    double      consumption;        /**< VNF resource consumption. **/
+    uint32_t    nameOffset;         /**< Position of the name in the string section. **/
+    uint32_t    nameLength;         /**< Length of the name. **/
+};
+
+/** A demand record. **/
+struct SnapshotDemand {
+    int32_t     source;             /**< Demand source node id. **/
+    int32_t     target;             /**< Demand target node id. **/
+    double      maxLatency;         /**< Demand maximum latency. **/
+    double      bandwidth;          /**< Demand requested bandwidth. **/
+    double      availability;       /**< Demand requested availability. **/
+    uint64_t    chainOffset;        /**< Position of the demand's first VNF in the chain section. **/
+    uint32_t    chainLength;        /**< Number of VNFs requested by the demand. **/
+    uint32_t    nameOffset;         /**< Position of the name in the string section. **/
+    uint32_t    nameLength;         /**< Length of the name. **/
+    uint32_t    padding;            /**< Unused. Keeps the record size a multiple of 8. **/
+};
+
+/** Byte offsets of every section of a snapshot, computed from its header. **/
+struct SnapshotLayout {
+    uint64_t    nodes;
+    uint64_t    links;
+    uint64_t    vnfs;
+    uint64_t    demands;
+    uint64_t    placementCost;
+    uint64_t    chains;
+    uint64_t    strings;
+    uint64_t    total;              /**< Expected size of the whole file. **/
+
+    /** Constructor. Computes the sections positions. @param header The snapshot header. **/
+    SnapshotLayout(const SnapshotHeader& header);
+};
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/** Returns a fingerprint of the input files (paths, sizes and modification times). A snapshot is only reused if it was built from files with the same fingerprint. @param params The input parameters. **/
+uint64_t getInputFingerprint(const Input& params);
+
+/** Returns true if the given file exists and can be read. @param filename The file path. **/
+bool isReadable(const std::string& filename);
+
+#endif
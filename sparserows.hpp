@@ -0,0 +1,69 @@
+#ifndef __sparserows__hpp
+#define __sparserows__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+
+
+/****************************************************************************************
+ * This class buffers linear rows lb <= sum value * column <= ub in sparse form, without
+ * any solver object: the entries of every row are stored one after the other, as column
+ * indices and values, and row r owns the entries offsets[r] ... offsets[r+1]-1. Being 
+ * plain memory, buffers can be filled by several threads at once, one buffer each, and 
+ * handed to the solver afterwards.
+****************************************************************************************/
+class SparseRows {
+
+private:
+    std::vector<int>        offsets;    /**< First entry of each row, plus one past the last entry. **/
+    std::vector<int>        indices;    /**< Column index of each entry. **/
+    std::vector<double>     values;     /**< Coefficient of each entry. **/
+    std::vector<double>     lower;      /**< Lower bound of each row. **/
+    std::vector<double>     upper;      /**< Upper bound of each row. **/
+    std::vector<int>        ids;        /**< Id of each row in its family. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+    /** Constructor. Builds an empty buffer. **/
+    SparseRows() : offsets(1, 0) {}
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Removes every row. Memory is kept. **/
+    void    clear()                                 { offsets.assign(1, 0); indices.clear(); values.clear(); lower.clear(); upper.clear(); ids.clear(); }
+
+    /** Adds an entry to the row being filled. @param index The column index. @param value The coefficient. **/
+    void    add(const int index, const double value){ indices.push_back(index); values.push_back(value); }
+
+    /** Closes the row being filled: the entries added since the last close become a row. @param id The id of the row in its family. @param lb The lower bound. @param ub The upper bound. **/
+    void    close(const int id, const double lb, const double ub) { offsets.push_back((int)indices.size()); lower.push_back(lb); upper.push_back(ub); ids.push_back(id); }
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the number of closed rows. **/
+    int     getNbRows()                     const { return (int)lower.size(); }
+    /** Returns the first entry of row r. **/
+    int     begin(const int r)              const { return offsets[r]; }
+    /** Returns one past the last entry of row r. **/
+    int     end(const int r)                const { return offsets[r+1]; }
+    /** Returns the column index of entry n. **/
+    int     getIndex(const int n)           const { return indices[n]; }
+    /** Returns the coefficient of entry n. **/
+    double  getValue(const int n)           const { return values[n]; }
+    /** Returns the lower bound of row r. **/
+    double  getLower(const int r)           const { return lower[r]; }
+    /** Returns the upper bound of row r. **/
+    double  getUpper(const int r)           const { return upper[r]; }
+    /** Returns the id of row r in its family. **/
+    int     getId(const int r)              const { return ids[r]; }
+};
+
+#endif
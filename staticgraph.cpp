@@ -0,0 +1,31 @@
+#include "staticgraph.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+StaticGraph::StaticGraph(const int nbNodes, const std::vector<Link>& tabLinks) : offsets(nbNodes + 1, 0)
+{
+    /* Count the arcs leaving each node. */
+    for (unsigned int i = 0; i < tabLinks.size(); i++){
+        offsets[tabLinks[i].getSource() + 1]++;
+    }
+    for (int v = 0; v < nbNodes; v++){
+        offsets[v + 1] += offsets[v];
+    }
+
+    /* Place each arc in its source's range, keeping the links order. */
+    targets.resize(tabLinks.size());
+    links.resize(tabLinks.size());
+    delays.resize(tabLinks.size());
+    bandwidths.resize(tabLinks.size());
+    std::vector<int> position(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i = 0; i < tabLinks.size(); i++){
+        int a = position[tabLinks[i].getSource()]++;
+        targets[a]    = tabLinks[i].getTarget();
+        links[a]      = tabLinks[i].getId();
+        delays[a]     = tabLinks[i].getDelay();
+        bandwidths[a] = tabLinks[i].getBandwidth();
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef __staticgraph__hpp
+#define __staticgraph__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+
+/*** Own Libraries ***/
+#include "link.hpp"
+
+
+/****************************************************************************************
+ * This class stores an immutable directed graph in compressed sparse row (CSR) form. 
+ * The arcs leaving node v are the positions offsets[v] ... offsets[v+1]-1 of the arc
+ * arrays, which hold the arc's target, delay, bandwidth and the id of its link. Nodes
+ * are identified by their ids, so no lookup is needed while traversing the graph.
+****************************************************************************************/
+class StaticGraph{
+    private:
+        std::vector<int>    offsets;        /**< First arc of each node, plus one past the last arc. **/
+        std::vector<int>    targets;        /**< Target node id of each arc. **/
+        std::vector<int>    links;          /**< Link id of each arc. **/
+        std::vector<double> delays;         /**< Delay of each arc. **/
+        std::vector<double> bandwidths;     /**< Bandwidth of each arc. **/
+
+    public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+
+	/** Constructor. Builds an empty graph. **/
+	StaticGraph() {}
+
+	/** Constructor. Builds the graph in O(|V| + |L|) by a counting sort of the links on their source. @param nbNodes The number of nodes. @param tabLinks The links, whose endpoints are node ids. **/
+	StaticGraph(const int nbNodes, const std::vector<Link>& tabLinks);
+
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+
+	/** Returns the number of nodes. **/
+	int 		getNbNodes() 			 const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+	/** Returns the number of arcs. **/
+	int 		getNbArcs() 			 const { return (int)targets.size(); }
+	/** Returns the first arc leaving node v. @param v The node id. **/
+	int 		begin(const int v) 		 const { return offsets[v]; }
+	/** Returns one past the last arc leaving node v. @param v The node id. **/
+	int 		end(const int v) 		 const { return offsets[v+1]; }
+	/** Returns the target of an arc. @param a The arc position. **/
+	int 		getTarget(const int a) 	 const { return targets[a]; }
+	/** Returns the id of the link associated with an arc. @param a The arc position. **/
+	int 		getLink(const int a) 	 const { return links[a]; }
+	/** Returns the delay of an arc. @param a The arc position. **/
+	double 		getDelay(const int a) 	 const { return delays[a]; }
+	/** Returns the bandwidth of an arc. @param a The arc position. **/
+	double 		getBandwidth(const int a) const { return bandwidths[a]; }
+
+	/** Returns the offsets array. **/
+	const std::vector<int>& 	getOffsets() 	const { return offsets; }
+	/** Returns the targets array. **/
+	const std::vector<int>& 	getTargets() 	const { return targets; }
+	/** Returns the link ids array. **/
+	const std::vector<int>& 	getLinks() 		const { return links; }
+	/** Returns the delays array. **/
+	const std::vector<double>& 	getDelays() 	const { return delays; }
+	/** Returns the bandwidths array. **/
+	const std::vector<double>& 	getBandwidths() const { return bandwidths; }
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/** Constructor. Sets every counter to zero. **/
+CallbackStats::Shard::Shard(const int nbDemands) : cutsPerDemand(new std::atomic<long>[nbDemands])
+{
+    for (int c = 0; c < NB_CONTEXT_TYPES; c++){
+        invocations[c].store(0);
+        skippedDemands[c].store(0);
+        for (int b = 0; b < NB_LATENCY_BUCKETS; b++){
+            latency[c][b].store(0);
+        }
+    }
+    time.store(0.0);
+    userCuts.store(0);
+    lazyConstraints.store(0);
+    skippedRounds.store(0);
+    heuristicRuns.store(0);
+    heuristicSolutions.store(0);
+    for (int k = 0; k < nbDemands; k++){
+        cutsPerDemand[k].store(0);
+    }
+}
+
+/** Constructor. **/
+CallbackStats::CallbackStats(const int nbThreads, const int nbDemands_) : nbDemands(nbDemands_)
+{
+    for (int t = 0; t < nbThreads; t++){
+        shards.push_back(std::unique_ptr<Shard>(new Shard(nbDemands)));
+    }
+}
+
+/****************************************************************************************/
+/*								        Recording    									*/
+/****************************************************************************************/
+
+/* Records an invocation of the callback. */
+void CallbackStats::addInvocation(const int thread, const ContextType type, const double seconds)
+{
+    Shard& shard = *shards[thread];
+    increment(shard.invocations[type]);
+    shard.time.store(shard.time.load(std::memory_order_relaxed) + seconds, std::memory_order_relaxed);
+
+    double microseconds = seconds * 1e6;
+    int bucket = 0;
+    if (microseconds >= 1.0){
+        bucket = std::min(NB_LATENCY_BUCKETS - 1, 1 + (int)std::log2(microseconds));
+    }
+    increment(shard.latency[type][bucket]);
+}
+
+/* Records a user cut. */
+void CallbackStats::addUserCut(const int thread, const int k)
+{
+    increment(shards[thread]->userCuts);
+    increment(shards[thread]->cutsPerDemand[k]);
+}
+
+/* Records a lazy constraint. */
+void CallbackStats::addLazyConstraint(const int thread, const int k)
+{
+    increment(shards[thread]->lazyConstraints);
+    increment(shards[thread]->cutsPerDemand[k]);
+}
+
+/* Records a relaxation left without separation. */
+void CallbackStats::addSkippedRound(const int thread)
+{
+    increment(shards[thread]->skippedRounds);
+}
+
+/* Records a run of the rounding heuristic. */
+void CallbackStats::addHeuristicRun(const int thread, const bool posted)
+{
+    increment(shards[thread]->heuristicRuns);
+    if (posted){
+        increment(shards[thread]->heuristicSolutions);
+    }
+}
+
+/* Records a demand not checked again because its values did not change. */
+void CallbackStats::addSkippedDemand(const int thread, const ContextType type)
+{
+    increment(shards[thread]->skippedDemands[type]);
+}
+
+/****************************************************************************************/
+/*								      Query Methods	    	    	    				*/
+/****************************************************************************************/
+
+long CallbackStats::getNbInvocations(const ContextType type) const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->invocations[type].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbUserCuts() const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->userCuts.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbLazyConstraints() const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->lazyConstraints.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbSkippedRounds() const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->skippedRounds.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbHeuristicRuns() const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->heuristicRuns.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbHeuristicSolutions() const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->heuristicSolutions.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbSkippedDemands(const ContextType type) const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->skippedDemands[type].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getNbCutsOfDemand(const int k) const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->cutsPerDemand[k].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double CallbackStats::getTime() const
+{
+    double total = 0.0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->time.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+long CallbackStats::getLatencyCount(const ContextType type, const int bucket) const
+{
+    long total = 0;
+    for (unsigned int t = 0; t < shards.size(); t++){
+        total += shards[t]->latency[type][bucket].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/****************************************************************************************/
+/*										Display											*/
+/****************************************************************************************/
+
+/* Displays the invocations, latency histograms and the demands that received the most cuts. */
+void CallbackStats::print() const
+{
+    const char* names[NB_CONTEXT_TYPES] = { "Relaxation", "Candidate" };
+    std::cout << "=> Callback statistics ..." << std::endl;
+    for (int c = 0; c < NB_CONTEXT_TYPES; c++){
+        ContextType type = (ContextType)c;
+        std::cout << "\t " << names[c] << " invocations: " << getNbInvocations(type) << std::endl;
+        std::cout << "\t\t Unchanged demands skipped: " << getNbSkippedDemands(type) << std::endl;
+        for (int b = 0; b < NB_LATENCY_BUCKETS; b++){
+            long count = getLatencyCount(type, b);
+            if (count > 0){
+                double lower = (b == 0) ? 0.0 : std::ldexp(1.0, b - 1);
+                std::cout << "\t\t [" << lower << ", " << std::ldexp(1.0, b) << ") us: " << count << std::endl;
+            }
+        }
+    }
+
+    std::cout << "\t Relaxations skipped by the separation policy: " << getNbSkippedRounds() << std::endl;
+    std::cout << "\t Rounding heuristic: " << getNbHeuristicSolutions() << " solutions posted in " << getNbHeuristicRuns() << " runs" << std::endl;
+
+    /* Demands that received the most cuts. */
+    std::vector<int> demands;
+    for (int k = 0; k < nbDemands; k++){
+        if (getNbCutsOfDemand(k) > 0){
+            demands.push_back(k);
+        }
+    }
+    std::sort(demands.begin(), demands.end(), [this](const int a, const int b){ return getNbCutsOfDemand(a) > getNbCutsOfDemand(b); });
+    std::cout << "\t Demands with cuts: " << demands.size() << std::endl;
+    for (unsigned int j = 0; j < demands.size() && j < 10; j++){
+        std::cout << "\t\t Demand " << demands[j] << ": " << getNbCutsOfDemand(demands[j]) << " cuts" << std::endl;
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef __stats__hpp
+#define __stats__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/****************************************************************************************/
+/*										DEFINES			    							*/
+/****************************************************************************************/
+#define CACHE_LINE_SIZE         64  // Bytes in a cache line
+#define NB_LATENCY_BUCKETS      24  // Bucket b > 0 of a latency histogram counts durations in [2^(b-1), 2^b) microseconds
+
+
+/************************************************************************************
+ * This class collects statistics about the callback. Counters are sharded by CPLEX 
+ * thread: each thread only writes its own shard, which is padded to whole cache 
+ * lines, so recording never takes a lock nor bounces a cache line between threads. 
+ * Values are aggregated over all shards when read.
+ ************************************************************************************/
+class CallbackStats {
+
+public:
+    /** The contexts the callback is invoked from. **/
+    enum ContextType { 
+        RELAXATION = 0,
+        CANDIDATE = 1,
+        NB_CONTEXT_TYPES = 2
+    };
+
+private:
+    /** The counters of one thread. **/
+    struct Shard {
+        char                    paddingBefore[CACHE_LINE_SIZE];                         /**< Keeps the counters away from the previous allocation. **/
+        std::atomic<long>       invocations[NB_CONTEXT_TYPES];                          /**< Number of invocations per context. **/
+        std::atomic<long>       latency[NB_CONTEXT_TYPES][NB_LATENCY_BUCKETS];          /**< Histogram of the invocation durations per context. **/
+        std::atomic<double>     time;                                                   /**< Total time spent in the callback. **/
+        std::atomic<long>       userCuts;                                               /**< Number of user cuts added. **/
+        std::atomic<long>       lazyConstraints;                                        /**< Number of lazy constraints added. **/
+        std::atomic<long>       skippedRounds;                                          /**< Number of relaxations left without separation by the policy. **/
+        std::atomic<long>       skippedDemands[NB_CONTEXT_TYPES];                       /**< Number of demands not checked again because their values did not change, per context. **/
+        std::atomic<long>       heuristicRuns;                                          /**< Number of runs of the rounding heuristic. **/
+        std::atomic<long>       heuristicSolutions;                                     /**< Number of solutions posted by the rounding heuristic. **/
+        std::unique_ptr<std::atomic<long>[]> cutsPerDemand;                             /**< Number of cuts and lazy constraints added for each demand. **/
+        char                    paddingAfter[CACHE_LINE_SIZE];                          /**< Keeps the counters away from the next allocation. **/
+
+        /** Constructor. Sets every counter to zero. @param nbDemands The number of demands. **/
+        Shard(const int nbDemands);
+    };
+
+    const int                           nbDemands;  /**< Number of demands. **/
+    std::vector<std::unique_ptr<Shard>> shards;     /**< The counters of each thread, indexed by CPLEX thread id. **/
+
+    /** Adds one to a counter owned by the calling thread. **/
+    static void increment(std::atomic<long>& counter) { counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param nbThreads The number of threads. @param nbDemands The number of demands. **/
+    CallbackStats(const int nbThreads, const int nbDemands);
+
+	/****************************************************************************************/
+	/*								        Recording    									*/
+	/****************************************************************************************/
+    /** Records an invocation of the callback. @param thread The calling thread. @param type The context. @param seconds The time spent in the invocation. **/
+    void addInvocation      (const int thread, const ContextType type, const double seconds);
+    /** Records a user cut. @param thread The calling thread. @param k The demand the cut was separated for. **/
+    void addUserCut         (const int thread, const int k);
+    /** Records a lazy constraint. @param thread The calling thread. @param k The demand the constraint was separated for. **/
+    void addLazyConstraint  (const int thread, const int k);
+    /** Records a relaxation left without separation. @param thread The calling thread. **/
+    void addSkippedRound    (const int thread);
+    /** Records a demand not checked again because its values did not change. @param thread The calling thread. @param type The context. **/
+    void addSkippedDemand   (const int thread, const ContextType type);
+    /** Records a run of the rounding heuristic. @param thread The calling thread. @param posted True if it posted a solution. **/
+    void addHeuristicRun    (const int thread, const bool posted);
+
+	/****************************************************************************************/
+	/*								      Query Methods	    	    	    				*/
+	/****************************************************************************************/
+    /** Returns the number of invocations from a given context. **/
+    long    getNbInvocations    (const ContextType type) const;
+    /** Returns the number of user cuts added. **/
+    long    getNbUserCuts       () const;
+    /** Returns the number of lazy constraints added. **/
+    long    getNbLazyConstraints() const;
+    /** Returns the number of relaxations left without separation. **/
+    long    getNbSkippedRounds  () const;
+    /** Returns the number of demands not checked again because their values did not change, in a given context. **/
+    long    getNbSkippedDemands (const ContextType type) const;
+    /** Returns the number of runs of the rounding heuristic. **/
+    long    getNbHeuristicRuns  () const;
+    /** Returns the number of solutions posted by the rounding heuristic. **/
+    long    getNbHeuristicSolutions() const;
+    /** Returns the number of cuts and lazy constraints added for demand k. **/
+    long    getNbCutsOfDemand   (const int k) const;
+    /** Returns the total time spent in the callback. **/
+    double  getTime             () const;
+    /** Returns the number of invocations from a given context whose duration falls in the given bucket. **/
+    long    getLatencyCount     (const ContextType type, const int bucket) const;
+
+	/****************************************************************************************/
+	/*										Display											*/
+	/****************************************************************************************/
+    /** Displays the invocations, latency histograms and the demands that received the most cuts. **/
+    void print() const;
+};
+
+#endif
@@ -9,7 +9,6 @@ VNF::VNF(const int id_, const std::string name_, const double cons, const int n)
             id(id_), name(name_), consumption(cons), nbNodes(n) 
 {
     placement_cost.resize(nbNodes, 0.0);
-    is_placed.resize(nbNodes, false);
 }
 
 /****************************************************************************************/
@@ -23,7 +23,6 @@ class VNF{
 		std::vector<double> 		placement_cost; 	/**< VNF cost of placement. **/
 
 		const int 			nbNodes; 	/**< Number of nodes in the network. **/
-		std::vector<bool>	is_placed;	/**< A vector of booleans stating whether or not the VNF is placed on each node. **/
 
 
     public:
@@ -0,0 +1,95 @@
+#include "workerpool.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/** Constructor. **/
+WorkerPool::WorkerPool(const int nbWorkers_) : nbWorkers(nbWorkers_ < 1 ? 1 : nbWorkers_), generation(0), nbRunning(0), stopping(false)
+{
+    for (int w = 1; w < nbWorkers; w++){
+        threads.push_back(std::thread(&WorkerPool::work, this, w));
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* The loop of worker thread w: waits for a job, runs it, reports. */
+void WorkerPool::work(const int w)
+{
+    long seen = 0;
+    while (true){
+        {
+            std::unique_lock<std::mutex> guard(state);
+            wake.wait(guard, [&]{ return stopping || generation != seen; });
+            if (stopping){
+                return;
+            }
+            seen = generation;
+        }
+        try {
+            job(w);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> guard(state);
+            if (!error){
+                error = std::current_exception();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> guard(state);
+            if (--nbRunning == 0){
+                done.notify_one();
+            }
+        }
+    }
+}
+
+/* Runs job(w) on every worker w and returns when all are done. */
+void WorkerPool::run(const std::function<void(const int)>& task)
+{
+    {
+        std::lock_guard<std::mutex> guard(state);
+        job = task;
+        error = nullptr;
+        nbRunning = nbWorkers - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    std::exception_ptr callerError;
+    try {
+        task(0);
+    }
+    catch (...) {
+        callerError = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> guard(state);
+    done.wait(guard, [&]{ return nbRunning == 0; });
+    if (callerError){
+        std::rethrow_exception(callerError);
+    }
+    if (error){
+        std::rethrow_exception(error);
+    }
+}
+
+/****************************************************************************************/
+/*										Destructors			    						*/
+/****************************************************************************************/
+
+/** Destructor. **/
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(state);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (unsigned int t = 0; t < threads.size(); t++){
+        threads[t].join();
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef __workerpool__hpp
+#define __workerpool__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/****************************************************************************************
+ * This class implements a fixed set of worker threads running the same job together.
+ * The thread calling run() takes part as worker 0, so a pool of n workers starts n-1
+ * threads, which sleep between jobs. Jobs usually share an atomic counter from which
+ * each worker takes the next chunk of work, so faster workers take more chunks. Only 
+ * one job runs at a time: callers hold the pool lock for the whole job and while using
+ * its results, and fall back to sequential work if they cannot get it.
+****************************************************************************************/
+class WorkerPool {
+
+private:
+    const int                       nbWorkers;  /**< Number of workers, including the caller. **/
+    std::vector<std::thread>        threads;    /**< The worker threads. **/
+    std::mutex                      lock;       /**< Held by the caller of run() for a whole job. **/
+
+    std::mutex                      state;      /**< Protects the members below. **/
+    std::condition_variable         wake;       /**< Signals a new job, or the end of the pool. **/
+    std::condition_variable         done;       /**< Signals the end of the current job. **/
+    std::function<void(const int)>  job;        /**< The current job, called with the worker id. **/
+    long                            generation; /**< Number of jobs started. **/
+    int                             nbRunning;  /**< Number of threads still running the current job. **/
+    bool                            stopping;   /**< True when the pool is being destroyed. **/
+    std::exception_ptr              error;      /**< First exception thrown by a thread during the current job. **/
+
+    /** The loop of worker thread w. **/
+    void work(const int w);
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Starts nbWorkers - 1 threads. @param nbWorkers The number of workers, including the caller. **/
+    WorkerPool(const int nbWorkers);
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns the number of workers, including the caller. **/
+    int         getNbWorkers() const { return nbWorkers; }
+
+    /** Returns the lock to be held while running a job and using its results. **/
+    std::mutex& getLock() { return lock; }
+
+    /** Runs job(w) on every worker w and returns when all are done. Rethrows the first exception thrown by a worker. @note The caller must hold the pool lock. **/
+    void        run(const std::function<void(const int)>& job);
+
+	/****************************************************************************************/
+	/*										Destructors			    						*/
+	/****************************************************************************************/
+    /** Destructor. Stops and joins the threads. **/
+    ~WorkerPool();
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "workspace.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+Workspace::Workspace(const IloEnv& env, const HotData& hot, const int thread_, const bool withSolution) :
+                thread(thread_), xSol(withSolution ? hot.getChainOffsets() : std::vector<int>(1, 0), withSolution ? hot.getCandidateOffsets() : std::vector<int>(1, 0), 0.0), 
+                xValues(env, withSolution ? (IloInt)hot.getNbColumns() : 0), cover(hot), lifter(hot), nbSkippedDemands(0), rounding(hot),
+                heuristicValues(env, withSolution ? (IloInt)hot.getNbColumns() + (IloInt)hot.getNbNodes() * hot.getNbVnfs() : 0)
+{
+    int maxSections = 0;
+    for (int k = 0; k < hot.getNbDemands(); k++){
+        maxSections = std::max(maxSections, hot.getNbSections(k));
+    }
+    coeff.reserve(maxSections, hot.getMaxCandidates());
+    nbLeaves = 1;
+    while (nbLeaves < hot.getMaxCandidates()){
+        nbLeaves *= 2;
+    }
+    candidateWeight.reserve(maxSections, nbLeaves);
+    candidateTree.reserve(maxSections, 2 * nbLeaves);
+    sectionFactor.reserve(maxSections);
+    sectionNodes.reserve(maxSections, hot.getMaxCandidates());
+    nbSectionNodes.reserve(maxSections);
+    sectionAvailability.reserve(maxSections);
+    sectionLogFailure.reserve(maxSections);
+    sectionLogAvailability.reserve(maxSections);
+    sectionMap.reserve(maxSections);
+    support.reserve((std::size_t)maxSections * hot.getMaxCandidates());
+    relaxationFingerprint.assign(hot.getNbDemands(), 0);
+    relaxationViolated.assign(hot.getNbDemands(), 1);
+    candidateFingerprint.assign(hot.getNbDemands(), 0);
+    candidatePlacement.assign(withSolution ? hot.getNbColumns() : 0, 0);
+    candidateViolated.assign(hot.getNbDemands(), 1);
+    candidateLogFailure.assign(hot.getNbSections(), 0.0);
+    cutOffset.reserve(hot.getNbDemands() + 1);
+    cutDemand.reserve(hot.getNbDemands());
+    cutLhs.reserve(hot.getNbDemands());
+    clearCuts();
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Reshapes the per demand buffers for a demand with the given number of sections. */
+void Workspace::reset(const int nbSections, const int nbCandidates)
+{
+    coeff.assign(nbSections, nbCandidates, 1);
+    candidateWeight.assign(nbSections, nbLeaves, -1.0);
+    candidateTree.assign(nbSections, 2 * nbLeaves, -1);
+    sectionFactor.assign(nbSections, 0.0);
+    sectionNodes.assign(nbSections, nbCandidates, -1);
+    nbSectionNodes.assign(nbSections, 0);
+    sectionAvailability.assign(nbSections, 0.0);
+    sectionLogFailure.assign(nbSections, 0.0);
+    sectionLogAvailability.assign(nbSections, 0.0);
+    sectionMap.clear();
+}
+
+/* Builds the candidate tree of section i, bottom-up. */
+void Workspace::buildCandidates(const int i)
+{
+    int* tree = candidateTree.row(i);
+    const double* weight = candidateWeight.row(i);
+    for (int p = 0; p < nbLeaves; p++){
+        tree[nbLeaves + p] = p;
+    }
+    for (int n = nbLeaves - 1; n > 0; n--){
+        tree[n] = (weight[tree[2*n+1]] > weight[tree[2*n]]) ? tree[2*n+1] : tree[2*n];
+    }
+}
+
+/* Returns the best candidate of section i among its nbFirst candidates of lowest availability. Ties go to the lowest rank. */
+int Workspace::getBestCandidate(const int i, const int nbFirst) const
+{
+    const int* tree = candidateTree.row(i);
+    const double* weight = candidateWeight.row(i);
+    int best = -1;
+    for (int l = nbLeaves, r = nbLeaves + nbFirst; l < r; l /= 2, r /= 2){
+        if (l % 2 == 1){
+            int p = tree[l++];
+            if (best == -1 || weight[p] > weight[best] || (weight[p] == weight[best] && p < best)){
+                best = p;
+            }
+        }
+        if (r % 2 == 1){
+            int p = tree[--r];
+            if (best == -1 || weight[p] > weight[best] || (weight[p] == weight[best] && p < best)){
+                best = p;
+            }
+        }
+    }
+    if (best == -1 || weight[best] < 0.0){
+        return -1;
+    }
+    return best;
+}
+
+/* Removes the candidate of rank q from section i and repairs its ancestors. */
+void Workspace::removeCandidate(const int i, const int q)
+{
+    int* tree = candidateTree.row(i);
+    const double* weight = candidateWeight.row(i);
+    candidateWeight(i, q) = -1.0;
+    for (int n = (nbLeaves + q) / 2; n > 0; n /= 2){
+        tree[n] = (weight[tree[2*n+1]] > weight[tree[2*n]]) ? tree[2*n+1] : tree[2*n];
+    }
+}
+
+/* Empties the cut buffer. Capacity is kept, so buffering the next round allocates nothing once it is warm. */
+void Workspace::clearCuts()
+{
+    cutDemand.clear();
+    cutSupport.clear();
+    cutLhs.clear();
+    cutOffset.assign(1, 0);
+    nbSkippedDemands = 0;
+}
+
+/* Appends the current support to the cut buffer. */
+void Workspace::bufferCut(const int k, const double lhs)
+{
+    cutDemand.push_back(k);
+    cutLhs.push_back(lhs);
+    cutSupport.insert(cutSupport.end(), support.begin(), support.end());
+    cutOffset.push_back((int)cutSupport.size());
+}
+
+/* Frees the Concert memory. */
+void Workspace::end()
+{
+    xValues.end();
+    heuristicValues.end();
+}
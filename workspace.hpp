@@ -0,0 +1,115 @@
+#ifndef __workspace__hpp
+#define __workspace__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <vector>
+#include <algorithm>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+
+/*** Own Libraries ***/
+#include "../instance/hotdata.hpp"
+#include "../tools/matrix.hpp"
+#include "coverseparator.hpp"
+#include "coverlifter.hpp"
+#include "rounding.hpp"
+#include "../tools/fingerprint.hpp"
+
+
+/****************************************************************************************
+ * This class gathers the scratch memory used by one CPLEX thread while separating
+ * availability constraints. Every buffer is allocated once, for the longest chain and
+ * the largest candidate set, and is then reshaped for each demand without touching the 
+ * heap. Nodes are designated by their position among the candidates of their section.
+****************************************************************************************/
+class Workspace {
+
+public:
+    /*** Owner ***/
+    const int                   thread;             /**< Id of the CPLEX thread owning the workspace. **/
+
+    /*** Solution ***/
+    RaggedMatrix<IloNum>        xSol;               /**< The current solution, one value per column: xSol(k, i, p) is the value of the p-th candidate of the i-th section of demand k. **/
+    IloNumArray                 xValues;            /**< The current solution as returned by CPLEX, in the same order. **/
+
+    /*** Per demand scratch ***/
+    FlatMatrix<int>             coeff;              /**< Coefficient of each (section, candidate) variable in the cut being built. **/
+    FlatMatrix<int>             sectionNodes;       /**< Candidates placed on each section; only the first nbSectionNodes[i] entries of row i are used. **/
+    std::vector<int>            nbSectionNodes;     /**< Number of nodes placed on each section. **/
+    std::vector<double>         sectionAvailability;/**< Availability of each section. **/
+    std::vector<double>         sectionLogFailure;  /**< Logarithm of the failure probability of each section. **/
+    std::vector<double>         sectionLogAvailability; /**< Logarithm of the availability of each section. **/
+    std::vector<MapAvailability> sectionMap;        /**< Availability of each section, with its id, for sorting. **/
+    std::vector<int>            support;            /**< Positions in the storage order of x of the variables of the cut being built. **/
+
+    /*** Greedy candidates ***/
+    int                         nbLeaves;           /**< Number of leaves of each candidate tree: the largest number of candidates of a section rounded up to a power of two. **/
+    FlatMatrix<double>          candidateWeight;    /**< Weight of the q-th candidate by increasing availability of each section, or -1 if it is not available. **/
+    FlatMatrix<int>             candidateTree;      /**< One max segment tree per section over the candidate weights: entry n holds the position of the best leaf below tree node n. **/
+    std::vector<double>         sectionFactor;      /**< Chain availability gained per unit of node availability when placing a node on each section. **/
+
+    /*** Change detection: what the thread saw the last time it checked each demand ***/
+    std::vector<uint64_t>       relaxationFingerprint;  /**< Fingerprint of the fractional values of each demand. **/
+    std::vector<char>           relaxationViolated;     /**< 1 if a cut was found for the demand, or if it was never checked. **/
+    std::vector<uint64_t>       candidateFingerprint;   /**< Fingerprint of the placements of each demand. **/
+    std::vector<char>           candidatePlacement;     /**< The placements themselves, one entry per column: 1 if the column was placed. **/
+    std::vector<char>           candidateViolated;      /**< 1 if the demand was violated, or if it was never checked. **/
+    std::vector<double>         candidateLogFailure;    /**< Logarithm of the failure probability of each section, indexed by flat section id. **/
+
+    /*** Knapsack separation ***/
+    CoverSeparator              cover;              /**< Buffers of the knapsack cover separation. **/
+
+    /*** Lifting ***/
+    CoverLifter                 lifter;             /**< Buffers of the lazy constraints lifting. **/
+
+    /*** Cuts found but not added yet, in increasing demand order ***/
+    std::vector<int>            cutDemand;          /**< Demand of each buffered cut. **/
+    std::vector<int>            cutOffset;          /**< Start of the support of each buffered cut in cutSupport, plus a final end offset. **/
+    std::vector<int>            cutSupport;         /**< Supports of the buffered cuts, one after the other. **/
+    std::vector<double>         cutLhs;             /**< Value of the left-hand side of each buffered cut on the current solution. **/
+    int                         nbSkippedDemands;   /**< Number of demands skipped since the buffer was last cleared. **/
+
+    /*** Primal heuristic ***/
+    RoundingHeuristic           rounding;           /**< Buffers of the rounding heuristic. **/
+    IloNumArray                 heuristicValues;    /**< The values of the x and then y variables of the solution posted to CPLEX. **/
+
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+    /** Constructor. Allocates every buffer for the longest chain of the instance. @param env The IBM environment. @param hot The instance data. @param thread The id of the owning thread. @param withSolution False for workspaces only used as scratch by separation workers, which read the solution of another workspace. **/
+    Workspace(const IloEnv& env, const HotData& hot, const int thread, const bool withSolution = true);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Reshapes the per demand buffers for a demand with the given number of sections. No memory is allocated. @param nbSections The number of sections of the demand. @param nbCandidates The largest number of candidates of a section. **/
+    void reset(const int nbSections, const int nbCandidates);
+
+    /** Builds the candidate tree of section i from the weights in row i of candidateWeight. **/
+    void buildCandidates(const int i);
+
+    /** Returns the rank of the best candidate of section i among its nbFirst candidates of lowest availability, or -1 if there is none. **/
+    int  getBestCandidate(const int i, const int nbFirst) const;
+
+    /** Removes the candidate of rank q from section i. **/
+    void removeCandidate(const int i, const int q);
+
+    /** Empties the cut buffer and resets the skipped demands counter. **/
+    void clearCuts();
+
+    /** Appends the current support to the cut buffer as a cut of demand k. @param k The demand id. @param lhs The value of the left-hand side of the cut. **/
+    void bufferCut(const int k, const double lhs);
+
+    /** Returns the number of buffered cuts. **/
+    int  getNbCuts() const { return (int)cutDemand.size(); }
+
+    /** Frees the Concert memory. **/
+    void end();
+};
+
+#endif